@@ -0,0 +1,858 @@
+module;
+
+#include <stdlib.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+export module bench;
+
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <cstddef>;
+import <cstdint>;
+import <deque>;
+import <forward_list>;
+import <iterator>;
+import <list>;
+import <mutex>;
+import <new>;
+import <optional>;
+import <ostream>;
+import <random>;
+import <string>;
+import <string_view>;
+import <thread>;
+import <unordered_map>;
+import <vector>;
+import xorlist;
+import xor_generator;
+import xor_lru_cache;
+import xor_slab_allocator;
+import xorlist_builder;
+
+// Keeps the optimizer from discarding a computed value.
+template <class T> void do_not_optimize(const T &value) { asm volatile("" : : "g"(&value) : "memory"); }
+
+template <class F> double seconds(F &&f) {
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Hardware counters
+
+/*
+ * Cycles, instructions, last-level cache misses, data TLB misses and branch misses of the calling thread, in user
+ * space, read through `perf_event_open`. Each counter is opened on its own, so that those the CPU, the kernel or
+ * `perf_event_paranoid` refuse are simply missing; elsewhere than on Linux, they all are. When there are more counters
+ * than hardware registers, the kernel multiplexes them and counts are scaled to the whole measured period.
+ */
+class perf_counters {
+  public:
+	static constexpr std::size_t count = 5;
+	static constexpr std::array<std::string_view, count> names = {"cycles", "instructions", "LLC-misses", "dTLB-misses",
+																  "branch-misses"};
+
+	// Counts of the last measurement, missing for the counters which are not available.
+	using readings = std::array<std::optional<double>, count>;
+
+  private:
+	std::array<int, count> _fds;
+
+  public:
+	explicit perf_counters(bool enabled = true) {
+		_fds.fill(-1);
+
+#ifdef __linux__
+		if (!enabled)
+			return;
+
+		constexpr auto cache_miss = [](std::uint64_t cache) {
+			return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		};
+		const std::array<std::pair<std::uint32_t, std::uint64_t>, count> events = {{
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+			{PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+			{PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB)},
+			{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+		}};
+
+		for (std::size_t i = 0; i < count; ++i) {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = events[i].first;
+			attr.config = events[i].second;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			_fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+#endif
+	}
+
+	perf_counters(const perf_counters &) = delete;
+	perf_counters &operator=(const perf_counters &) = delete;
+
+	~perf_counters() {
+#ifdef __linux__
+		for (const int fd : _fds)
+			if (fd >= 0)
+				::close(fd);
+#endif
+	}
+
+	bool available() const noexcept {
+		return std::any_of(_fds.begin(), _fds.end(), [](int fd) { return fd >= 0; });
+	}
+
+	void start() noexcept {
+#ifdef __linux__
+		for (const int fd : _fds)
+			if (fd >= 0) {
+				::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+	}
+
+	readings stop() noexcept {
+		readings counts;
+
+#ifdef __linux__
+		for (const int fd : _fds)
+			if (fd >= 0)
+				::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+		for (std::size_t i = 0; i < count; ++i) {
+			std::uint64_t value[3]; // count, time enabled, time running
+
+			if (_fds[i] >= 0 && ::read(_fds[i], value, sizeof(value)) == sizeof(value) && value[2] != 0)
+				counts[i] = double(value[0]) * double(value[1]) / double(value[2]);
+		}
+#endif
+
+		return counts;
+	}
+};
+
+// Micro-benchmarks
+
+/*
+ * One measurement of `value`, in `unit` per operation: per element for whole-container operations, per call for middle
+ * insert and erase, per element held for footprints. A case which was not run is reported as the operation "skipped",
+ * with the reason in `note`.
+ */
+export struct bench_result {
+	std::string suite, container, operation;
+	std::size_t element_size, length, ops;
+	double value;
+	std::string unit;
+	std::size_t threads = 1;
+	std::string note = {};
+};
+
+// Collected results, written as CSV or JSON for the scripts that compare runs.
+export class bench_report {
+	std::vector<bench_result> _results;
+
+  public:
+	void add(bench_result result) { _results.push_back(std::move(result)); }
+
+	const std::vector<bench_result> &results() const noexcept { return _results; }
+
+	void write_csv(std::ostream &out) const {
+		out << "suite,container,operation,element_size,length,ops,value,unit,threads,note\n";
+
+		for (const bench_result &r : _results)
+			out << r.suite << ',' << r.container << ',' << r.operation << ',' << r.element_size << ',' << r.length
+				<< ',' << r.ops << ',' << r.value << ',' << r.unit << ',' << r.threads << ',' << r.note << '\n';
+	}
+
+	void write_json(std::ostream &out) const {
+		out << "[\n";
+
+		for (std::size_t i = 0; i < _results.size(); ++i) {
+			const bench_result &r = _results[i];
+			out << "  {\"suite\": \"" << r.suite << "\", \"container\": \"" << r.container << "\", \"operation\": \""
+				<< r.operation << "\", \"element_size\": " << r.element_size << ", \"length\": " << r.length
+				<< ", \"ops\": " << r.ops << ", \"value\": " << r.value << ", \"unit\": \"" << r.unit
+				<< "\", \"threads\": " << r.threads << ", \"note\": \"" << r.note << "\"}"
+				<< (i + 1 == _results.size() ? "\n" : ",\n");
+		}
+
+		out << "]\n";
+	}
+};
+
+export struct bench_options {
+	std::vector<std::size_t> lengths = {10, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000};
+	// cases whose nodes would take more memory are skipped, and reported as such with their estimated footprint
+	std::size_t max_bytes = std::size_t(1) << 30;
+	// elements processed per measurement, spread over as many containers as needed for short lengths
+	std::size_t batch_elements = std::size_t(1) << 20;
+	// whether to report hardware counters too, where available
+	bool counters = true;
+};
+
+// An empty base takes no space, where even a zero-length `std::array` member would.
+template <std::size_t N> struct padding {
+	std::array<std::uint8_t, N> bytes{};
+};
+
+template <> struct padding<0> {};
+
+// Element of `N` bytes ordered by its key.
+template <std::size_t N> struct payload : padding<N - sizeof(std::uint32_t)> {
+	std::uint32_t key;
+
+	payload(std::uint32_t key = 0) : key(key) {}
+
+	friend bool operator==(const payload &x, const payload &y) noexcept { return x.key == y.key; }
+	friend auto operator<=>(const payload &x, const payload &y) noexcept { return x.key <=> y.key; }
+};
+
+template <class C> constexpr std::string_view container_name = "";
+template <class T, class A> constexpr std::string_view container_name<xorlist<T, A>> = "xorlist";
+template <class T, class A> constexpr std::string_view container_name<std::list<T, A>> = "std::list";
+template <class T, class A> constexpr std::string_view container_name<std::forward_list<T, A>> = "std::forward_list";
+template <class T, class A> constexpr std::string_view container_name<std::deque<T, A>> = "std::deque";
+template <class T, class A> constexpr std::string_view container_name<std::vector<T, A>> = "std::vector";
+
+struct batch_measurement {
+	double seconds;
+	perf_counters::readings counts;
+};
+
+/*
+ * Prepares `containers` states with `setup`, untimed, then measures `op` over all of them. States are set up in place,
+ * so that iterators held by a state stay valid.
+ */
+template <class State, class Setup, class Op>
+batch_measurement time_batch(std::size_t containers, perf_counters &counters, Setup setup, Op op) {
+	std::vector<State> states(containers);
+
+	for (State &state : states)
+		setup(state);
+
+	counters.start();
+	const double elapsed = seconds([&] {
+		for (State &state : states)
+			op(state);
+	});
+
+	return {elapsed, counters.stop()};
+}
+
+template <class C, class T> struct bench_case {
+	using value_type = T;
+
+	bench_report &report;
+	const bench_options &options;
+	perf_counters &counters;
+	std::size_t length;
+	std::vector<value_type> values; // random keys
+
+	std::size_t containers() const { return std::max<std::size_t>(1, options.batch_elements / length); }
+
+	template <class State, class Setup, class Op>
+	void run(std::string_view operation, std::size_t ops_per_container, Setup setup, Op op) {
+		const std::size_t ops = containers() * ops_per_container;
+		const batch_measurement m = time_batch<State>(containers(), counters, setup, op);
+		const auto add = [&](double total, std::string_view unit) {
+			report.add({"micro", std::string(container_name<C>), std::string(operation), sizeof(value_type), length,
+						ops, total / double(ops), std::string(unit)});
+		};
+
+		add(m.seconds * 1e9, "ns");
+
+		for (std::size_t i = 0; i < perf_counters::count; ++i)
+			if (m.counts[i])
+				add(*m.counts[i], perf_counters::names[i]);
+	}
+
+	// `xorlist::assign` is not usable with iterators yet, so all containers are filled alike
+	template <class R> static void fill(C &c, const R &source) {
+		for (const value_type &v : source)
+			c.push_back(v);
+	}
+
+	void fill(C &c) const { fill(c, values); }
+
+	void all() {
+		const std::size_t n = length;
+		const std::size_t middle_ops = std::clamp<std::size_t>(n / 10, 1, 1000);
+
+		run<std::optional<C>>("construct", n, [](auto &) {}, [&](auto &c) { c.emplace(values.begin(), values.end()); });
+
+		run<C>("push_back", n, [](C &) {}, [&](C &c) {
+			for (const value_type &v : values)
+				c.push_back(v);
+		});
+
+		if constexpr (requires(C &c, const value_type &v) { c.push_front(v); })
+			run<C>("push_front", n, [](C &) {}, [&](C &c) {
+				for (const value_type &v : values)
+					c.push_front(v);
+			});
+
+		run<C>("pop_back", n, [&](C &c) { fill(c); }, [](C &c) {
+			while (!c.empty())
+				c.pop_back();
+		});
+
+		if constexpr (requires(C &c) { c.pop_front(); })
+			run<C>("pop_front", n, [&](C &c) { fill(c); }, [](C &c) {
+				while (!c.empty())
+					c.pop_front();
+			});
+
+		run<C>("iterate", n, [&](C &c) { fill(c); }, [](C &c) {
+			std::uint64_t sum = 0;
+			for (const value_type &v : c)
+				sum += v.key;
+			do_not_optimize(sum);
+		});
+
+		// Lists find the position once, untimed, then follow it through the iterators returned by insert and erase. A
+		// `xorlist` iterator holds the preceding node, so inserting before it invalidates it: the reassignments are
+		// required, not an optimization.
+		using position = std::pair<C, typename C::iterator>;
+		const auto find_middle = [&](position &p) {
+			fill(p.first);
+			p.second = std::next(p.first.begin(), static_cast<std::ptrdiff_t>(n / 2));
+		};
+
+		run<position>("insert_middle", middle_ops, find_middle, [&](position &p) {
+			for (std::size_t i = 0; i < middle_ops; ++i)
+				if constexpr (requires { p.first.splice(p.second, p.first); })
+					p.second = p.first.insert(p.second, values[i]);
+				else
+					p.first.insert(p.first.begin() + static_cast<std::ptrdiff_t>(p.first.size() / 2), values[i]);
+		});
+
+		run<position>("erase_middle", middle_ops, find_middle, [&](position &p) {
+			for (std::size_t i = 0; i < middle_ops; ++i)
+				if constexpr (requires { p.first.splice(p.second, p.first); })
+					p.second = p.first.erase(p.second);
+				else
+					p.first.erase(p.first.begin() + static_cast<std::ptrdiff_t>(p.first.size() / 2));
+		});
+
+		// sequences without splice append by moving the elements, which is what their users do instead
+		run<std::pair<C, C>>("splice", n, [&](std::pair<C, C> &p) { fill(p.first), fill(p.second); },
+							 [](std::pair<C, C> &p) {
+								 if constexpr (requires { p.first.splice(p.first.end(), p.second); })
+									 p.first.splice(p.first.end(), p.second);
+								 else {
+									 p.first.insert(p.first.end(), std::make_move_iterator(p.second.begin()),
+													std::make_move_iterator(p.second.end()));
+									 p.second.clear();
+								 }
+							 });
+
+		run<std::pair<C, C>>(
+			"merge", n,
+			[&](std::pair<C, C> &p) {
+				const auto half = values.begin() + static_cast<std::ptrdiff_t>(n / 2);
+				std::vector<value_type> sorted(values.begin(), half);
+				std::sort(sorted.begin(), sorted.end());
+				fill(p.first, sorted);
+				sorted.assign(half, values.end());
+				std::sort(sorted.begin(), sorted.end());
+				fill(p.second, sorted);
+			},
+			[](std::pair<C, C> &p) {
+				if constexpr (requires { p.first.merge(p.second); })
+					p.first.merge(p.second);
+				else {
+					const auto size = static_cast<std::ptrdiff_t>(p.first.size());
+					p.first.insert(p.first.end(), p.second.begin(), p.second.end());
+					std::inplace_merge(p.first.begin(), p.first.begin() + size, p.first.end());
+				}
+			});
+
+		run<C>("sort", n, [&](C &c) { fill(c); }, [](C &c) {
+			if constexpr (requires { c.sort(); })
+				c.sort();
+			else
+				std::sort(c.begin(), c.end());
+		});
+
+		run<C>("reverse", n, [&](C &c) { fill(c); }, [](C &c) {
+			if constexpr (requires { c.reverse(); })
+				c.reverse();
+			else
+				std::reverse(c.begin(), c.end());
+		});
+
+		run<C>("remove_if", n, [&](C &c) { fill(c); }, [](C &c) {
+			const auto odd = [](const value_type &v) { return v.key % 2 != 0; };
+			if constexpr (requires { c.remove_if(odd); })
+				c.remove_if(odd);
+			else
+				c.erase(std::remove_if(c.begin(), c.end(), odd), c.end());
+		});
+	}
+};
+
+template <std::size_t N>
+void micro_size(bench_report &report, const bench_options &options, perf_counters &counters) {
+	using T = payload<N>;
+	static_assert(sizeof(T) == N);
+
+	for (const std::size_t length : options.lengths) {
+		// a list node holds the element and up to two pointers
+		if (const std::size_t bytes = length * (sizeof(T) + 2 * sizeof(void *)); bytes > options.max_bytes) {
+			for (const std::string_view container : {container_name<xorlist<T>>, container_name<std::list<T>>,
+													 container_name<std::deque<T>>, container_name<std::vector<T>>})
+				report.add({"micro", std::string(container), "skipped", sizeof(T), length, 0, double(bytes), "B", 1,
+							"estimated footprint over max_bytes"});
+
+			continue;
+		}
+
+		std::mt19937 rng(static_cast<std::uint32_t>(length));
+		std::vector<T> values(length);
+
+		for (T &v : values)
+			v.key = static_cast<std::uint32_t>(rng());
+
+		bench_case<xorlist<T>, T>{report, options, counters, length, values}.all();
+		bench_case<std::list<T>, T>{report, options, counters, length, values}.all();
+		bench_case<std::deque<T>, T>{report, options, counters, length, values}.all();
+		bench_case<std::vector<T>, T>{report, options, counters, length, values}.all();
+	}
+}
+
+/*
+ * Every operation family of `xorlist`, against `std::list`, `std::deque` and `std::vector`, for elements of 4 to 256
+ * bytes and the lengths of `options`. Operations a container lacks are measured with the idiom its users would use
+ * instead, e.g. `std::sort` for `sort`, or skipped when there is none, e.g. `push_front` on a vector. Each case is
+ * reported in nanoseconds, and in the counts of the available `perf_counters`, per operation. Lengths whose estimated
+ * footprint exceeds `options.max_bytes` are reported as skipped rather than run: raise it to cover the whole sweep.
+ */
+export bench_report micro(const bench_options &options = {}) {
+	bench_report report;
+	perf_counters counters(options.counters);
+
+	micro_size<4>(report, options, counters);
+	micro_size<16>(report, options, counters);
+	micro_size<64>(report, options, counters);
+	micro_size<256>(report, options, counters);
+
+	return report;
+}
+
+// Memory footprint
+
+struct allocation_stats {
+	std::size_t blocks = 0;
+	std::size_t requested = 0; // bytes asked for
+	std::size_t heap = 0;	   // bytes taken from the heap, with the headers and padding of `malloc`
+};
+
+// Heap bytes behind a block of `size` bytes from `malloc`: with glibc, its usable size plus the chunk header.
+std::size_t heap_bytes(void *p, std::size_t size) noexcept {
+#ifdef __GLIBC__
+	return ::malloc_usable_size(p) + sizeof(std::size_t);
+#else
+	return size;
+#endif
+}
+
+// `malloc`-backed allocator accounting for the live blocks in shared `allocation_stats`.
+template <class T> class counting_allocator {
+	template <class U> friend class counting_allocator;
+
+	allocation_stats *_stats;
+
+  public:
+	using value_type = T;
+
+	explicit counting_allocator(allocation_stats &stats) noexcept : _stats(&stats) {}
+
+	template <class U> counting_allocator(const counting_allocator<U> &other) noexcept : _stats(other._stats) {}
+
+	[[nodiscard]] T *allocate(std::size_t n) {
+		static_assert(alignof(T) <= alignof(std::max_align_t));
+
+		void *p = std::malloc(n * sizeof(T));
+
+		if (p == nullptr)
+			throw std::bad_alloc();
+
+		++_stats->blocks;
+		_stats->requested += n * sizeof(T);
+		_stats->heap += heap_bytes(p, n * sizeof(T));
+
+		return static_cast<T *>(p);
+	}
+
+	void deallocate(T *p, std::size_t n) noexcept {
+		--_stats->blocks;
+		_stats->requested -= n * sizeof(T);
+		_stats->heap -= heap_bytes(p, n * sizeof(T));
+		std::free(p);
+	}
+
+	template <class U> bool operator==(const counting_allocator<U> &other) const noexcept {
+		return _stats == other._stats;
+	}
+};
+
+template <class C> void fill_keys(C &c, std::size_t length) {
+	for (std::size_t i = 0; i < length; ++i)
+		if constexpr (requires { c.push_back(typename C::allocator_type::value_type()); })
+			c.push_back(static_cast<std::uint32_t>(i));
+		else
+			c.push_front(static_cast<std::uint32_t>(i));
+}
+
+/*
+ * Reports the bytes per element of `C<T>` holding `length` elements, container object included: with
+ * `counting_allocator`, as taken from the heap, and with `xor_slab_allocator`, as held in slabs. The overhead is what
+ * exceeds `sizeof(T)`.
+ */
+template <template <class, class> class C, class T> void footprint_of(bench_report &report, std::size_t length) {
+	const auto add = [&](std::string container, std::size_t bytes) {
+		const double per_element = double(bytes) / double(length);
+
+		report.add({"footprint", container, "bytes_per_element", sizeof(T), length, length, per_element, "B"});
+		report.add({"footprint", std::move(container), "overhead_per_element", sizeof(T), length, length,
+					per_element - double(sizeof(T)), "B"});
+	};
+
+	{
+		allocation_stats stats;
+		C<T, counting_allocator<T>> c{counting_allocator<T>(stats)};
+		fill_keys(c, length);
+		add(std::string(container_name<decltype(c)>), stats.heap + sizeof(c));
+	}
+
+	{
+		xor_slab_allocator<T> alloc;
+		C<T, xor_slab_allocator<T>> c(alloc);
+		fill_keys(c, length);
+		add(std::string(container_name<decltype(c)>) + "/slab", alloc.allocated_bytes() + sizeof(c));
+	}
+}
+
+template <std::size_t N> void footprint_size(bench_report &report, const std::vector<std::size_t> &lengths) {
+	for (const std::size_t length : lengths) {
+		footprint_of<xorlist, payload<N>>(report, length);
+		footprint_of<std::list, payload<N>>(report, length);
+		footprint_of<std::forward_list, payload<N>>(report, length);
+	}
+}
+
+/*
+ * Memory taken per element by `xorlist`, `std::list` and `std::forward_list`, for elements of 4 to 256 bytes, with the
+ * default allocator, whose per-allocation headers are accounted for, and with `xor_slab_allocator`, whose unused slab
+ * space is. Short lengths show the cost of the container object, long ones the cost of a node.
+ */
+export bench_report footprint(const std::vector<std::size_t> &lengths = {1, 16, 1'000, 1'000'000}) {
+	bench_report report;
+
+	footprint_size<4>(report, lengths);
+	footprint_size<8>(report, lengths);
+	footprint_size<16>(report, lengths);
+	footprint_size<32>(report, lengths);
+	footprint_size<64>(report, lengths);
+	footprint_size<128>(report, lengths);
+	footprint_size<256>(report, lengths);
+
+	return report;
+}
+
+// LRU cache
+
+// Reference LRU: the usual std::list + std::unordered_map pair.
+template <class Key, class T> class list_lru_cache {
+	std::list<std::pair<Key, T>> _entries; // least recently used first
+	std::unordered_map<Key, typename std::list<std::pair<Key, T>>::iterator> _index;
+	std::size_t _capacity;
+
+  public:
+	explicit list_lru_cache(std::size_t capacity) : _capacity(capacity) { _index.reserve(capacity + 1); }
+
+	T *get(const Key &key) {
+		const auto it = _index.find(key);
+
+		if (it == _index.end())
+			return nullptr;
+
+		_entries.splice(_entries.end(), _entries, it->second);
+		return &it->second->second;
+	}
+
+	void put(const Key &key, const T &value) {
+		if (const auto it = _index.find(key); it != _index.end()) {
+			it->second->second = value;
+			_entries.splice(_entries.end(), _entries, it->second);
+			return;
+		}
+
+		_index.emplace(key, _entries.emplace(_entries.end(), key, value));
+
+		if (_entries.size() > _capacity) {
+			_index.erase(_entries.front().first);
+			_entries.pop_front();
+		}
+	}
+};
+
+template <class Cache>
+void lru_run(bench_report &report, std::string container, std::size_t capacity,
+			 const std::vector<std::uint64_t> &keys) {
+	Cache cache(capacity);
+	std::size_t hits = 0;
+
+	const double elapsed = seconds([&] {
+		for (const std::uint64_t key : keys)
+			if (const auto value = cache.get(key))
+				hits += *value != 0;
+			else
+				cache.put(key, key | 1);
+	});
+
+	do_not_optimize(hits);
+
+	const auto add = [&](double value, std::string unit) {
+		report.add({"lru", container, "get_or_put", sizeof(std::uint64_t), capacity, keys.size(), value,
+					std::move(unit)});
+	};
+
+	add(elapsed * 1e9 / double(keys.size()), "ns");
+	add(double(hits) / double(keys.size()) * 100, "% hits");
+}
+
+/*
+ * get-or-put workload over a key space twice the capacity, with a skewed (geometric) key popularity, against a
+ * `std::list` + `std::unordered_map` LRU. Each case is reported, per capacity, in nanoseconds per operation and in
+ * hit rate.
+ */
+export bench_report lru_cache() {
+	bench_report report;
+
+	for (const std::size_t capacity : {std::size_t(1) << 10, std::size_t(1) << 16, std::size_t(1) << 20}) {
+		std::mt19937_64 rng(capacity);
+		std::geometric_distribution<std::uint64_t> popularity(1.0 / double(capacity));
+		std::vector<std::uint64_t> keys(8 * capacity);
+
+		for (std::uint64_t &key : keys)
+			key = popularity(rng) % (2 * capacity);
+
+		lru_run<xor_lru_cache<std::uint64_t, std::uint64_t>>(report, "xor_lru_cache", capacity, keys);
+		lru_run<list_lru_cache<std::uint64_t, std::uint64_t>>(report, "list_lru_cache", capacity, keys);
+	}
+
+	return report;
+}
+
+// Concurrency scaling
+
+export struct scaling_options {
+	std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+	std::size_t elements = std::size_t(1) << 22; // in total, shared between the threads
+	std::size_t batch = 256;					 // elements per splice, pushed batch or builder chunk
+	std::size_t repetitions = 3;				 // the best time is kept
+};
+
+// Share of the lock acquisitions which found the lock taken.
+double contended_share(std::size_t acquisitions, std::size_t contended) noexcept {
+	return acquisitions == 0 ? 0 : double(contended) / double(acquisitions);
+}
+
+// Mutex counting the acquisitions which found it taken.
+class counting_mutex {
+	std::mutex _mutex;
+	std::size_t _acquisitions = 0, _contended = 0; // only updated while locked
+
+  public:
+	void lock() {
+		const bool contended = !_mutex.try_lock();
+
+		if (contended)
+			_mutex.lock();
+
+		++_acquisitions;
+		_contended += contended;
+	}
+
+	void unlock() { _mutex.unlock(); }
+
+	double contention() const noexcept { return contended_share(_acquisitions, _contended); }
+};
+
+struct scaling_run {
+	double seconds;
+	double contention; // share of contended lock acquisitions, on the shared list or inside the channel or builder
+};
+
+// Runs `body(i, count)` on threads `0` to `threads - 1`, where `count` is the share of the elements of thread `i`.
+template <class Body> void on_threads(std::size_t threads, std::size_t elements, Body body) {
+	std::vector<std::thread> workers;
+
+	for (std::size_t i = 0; i < threads; ++i)
+		workers.emplace_back(body, i, elements / threads + (i < elements % threads));
+
+	for (std::thread &worker : workers)
+		worker.join();
+}
+
+// Each thread builds batches privately and splices them into the shared list, one lock per batch.
+scaling_run local_build_splice(std::size_t threads, const scaling_options &options) {
+	xorlist<std::uint64_t> shared;
+	counting_mutex mutex;
+
+	const double elapsed = seconds([&] {
+		on_threads(threads, options.elements, [&](std::size_t, std::size_t count) {
+			xorlist<std::uint64_t> local;
+
+			for (std::size_t i = 0; i < count; ++i) {
+				local.push_back(i);
+
+				if (local.size() == options.batch || i + 1 == count) {
+					std::lock_guard lock(mutex);
+					shared.splice(shared.end(), local);
+				}
+			}
+		});
+	});
+
+	do_not_optimize(shared.size());
+	return {elapsed, mutex.contention()};
+}
+
+// Each thread pushes its elements into the shared list one by one, under a lock.
+scaling_run mutex_push(std::size_t threads, const scaling_options &options) {
+	xorlist<std::uint64_t> shared;
+	counting_mutex mutex;
+
+	const double elapsed = seconds([&] {
+		on_threads(threads, options.elements, [&](std::size_t, std::size_t count) {
+			for (std::size_t i = 0; i < count; ++i) {
+				std::lock_guard lock(mutex);
+				shared.push_back(i);
+			}
+		});
+	});
+
+	do_not_optimize(shared.size());
+	return {elapsed, mutex.contention()};
+}
+
+// The threads produce batches into an `xor_channel`, drained by one more consumer thread: SPSC with one thread.
+scaling_run channel(std::size_t threads, const scaling_options &options) {
+	xor_channel<std::uint64_t> queue;
+	std::uint64_t sum = 0;
+
+	const double elapsed = seconds([&] {
+		std::thread consumer([&] {
+			for (const std::uint64_t value : queue.async_drain())
+				sum += value;
+		});
+
+		on_threads(threads, options.elements, [&](std::size_t, std::size_t count) {
+			xorlist<std::uint64_t> batch;
+
+			for (std::size_t i = 0; i < count; ++i) {
+				batch.push_back(i);
+
+				if (batch.size() == options.batch || i + 1 == count)
+					queue.push_batch(std::move(batch));
+			}
+		});
+
+		queue.close();
+		consumer.join();
+	});
+
+	const auto stats = queue.lock_statistics();
+
+	do_not_optimize(sum);
+	return {elapsed, contended_share(stats.acquisitions, stats.contended)};
+}
+
+// `xorlist_builder` with as many workers as threads, fed by the calling thread.
+scaling_run builder(std::size_t threads, const scaling_options &options) {
+	std::size_t size = 0;
+	xorlist_builder<std::uint64_t>::lock_stats stats;
+
+	const double elapsed = seconds([&] {
+		xorlist_builder<std::uint64_t> build(threads);
+
+		for (std::size_t first = 0; first < options.elements; first += options.batch)
+			build.submit([first, last = std::min(first + options.batch, options.elements)](auto &sublist) {
+				for (std::size_t i = first; i < last; ++i)
+					sublist.push_back(i);
+			});
+
+		size = build.finish().size();
+		stats = build.lock_statistics();
+	});
+
+	do_not_optimize(size);
+	return {elapsed, contended_share(stats.acquisitions, stats.contended)};
+}
+
+/*
+ * Throughput against thread count, doubling from 1 up to `options.max_threads`, of the ways to fill a `xorlist` from
+ * several threads: private batches spliced into a shared list, pushes into a shared list under a mutex, an
+ * `xor_channel` drained by a consumer, and `xorlist_builder`. Each pattern is reported, per thread count, in millions
+ * of elements per second, as a speedup over its single-threaded run, and in share of lock acquisitions which had to
+ * wait for another thread: those of the benchmark on its shared list, or those counted by `xor_channel` and
+ * `xorlist_builder`.
+ */
+export bench_report scaling(const scaling_options &options = {}) {
+	using pattern = scaling_run (*)(std::size_t, const scaling_options &);
+	const std::pair<std::string_view, pattern> patterns[] = {{"local_build_splice", local_build_splice},
+															 {"mutex_push", mutex_push},
+															 {"channel", channel},
+															 {"builder", builder}};
+	bench_report report;
+	std::vector<std::size_t> thread_counts;
+
+	for (std::size_t threads = 1; threads < options.max_threads; threads *= 2)
+		thread_counts.push_back(threads);
+
+	thread_counts.push_back(options.max_threads);
+
+	for (const auto &[name, run] : patterns) {
+		double single = 0;
+
+		for (const std::size_t threads : thread_counts) {
+			scaling_run best = run(threads, options);
+
+			for (std::size_t i = 1; i < options.repetitions; ++i)
+				if (const scaling_run r = run(threads, options); r.seconds < best.seconds)
+					best = r;
+
+			if (threads == 1)
+				single = best.seconds;
+
+			const auto add = [&](double value, std::string unit) {
+				report.add({"scaling", "xorlist", std::string(name), sizeof(std::uint64_t), options.elements,
+							options.elements, value, std::move(unit), threads});
+			};
+
+			add(double(options.elements) / best.seconds * 1e-6, "Melem/s");
+			add(single / best.seconds, "speedup");
+
+			add(best.contention * 100, "% contended");
+		}
+	}
+
+	return report;
+}
@@ -0,0 +1,316 @@
+/*
+ * https://en.wikipedia.org/wiki/Copy-on-write
+ */
+export module cow_xorlist;
+
+import <cstddef>;
+
+import <algorithm>;
+import <atomic>;
+import <initializer_list>;
+import <iterator>;
+import <memory>;
+import <stdexcept>;
+import <utility>;
+
+import xorlist;
+
+/**
+ - [x] explicit cow_xorlist(size_type segment_capacity, const allocator_type& alloc);
+ - [x] template <class InputIt> cow_xorlist(InputIt first, InputIt last, size_type segment_capacity, const
+ allocator_type& alloc);
+ - [x] cow_xorlist(std::initializer_list<value_type> init, size_type segment_capacity, const allocator_type& alloc);
+ - [x] const_iterator begin() const noexcept; const_iterator end() const noexcept;
+ - [x] const_reference front() const; const_reference back() const;
+ - [x] size_type size() const noexcept; bool empty() const noexcept; size_type shared_segments() const noexcept;
+ - [x] void push_back(const value_type& value); void push_front(const value_type& value);
+ - [x] void pop_back(); void pop_front(); void clear();
+ - [x] const_iterator insert(const_iterator pos, const value_type& value);
+ - [x] void replace(const_iterator pos, const value_type& value);
+ - [x] const_iterator erase(const_iterator pos);
+ - [x] friend bool operator==(const cow_xorlist& lhs, const cow_xorlist& rhs);
+ */
+
+/*
+ * Copy-on-write list. Elements are stored in segments of up to `segment_capacity` consecutive elements, each a
+ * `xorlist`, listed in a table which is itself a `xorlist` of shared pointers to the segments. Copying a `cow_xorlist`
+ * only shares the table, in constant time. The first mutation of a copy clones the table, i.e. one pointer per
+ * segment, then the segment that it touches, if still shared: a copy that is never modified never copies an element,
+ * and a modified one only copies the segments it modifies.
+ * Elements are only readable through iterators, since writes through them would escape the copy-on-write.
+ * Notes: Each handle must be used by one thread at a time, but handles sharing storage can be used by different
+ * threads, as with `std::shared_ptr`.
+ */
+export template <class T, class Allocator = std::allocator<T>> class cow_xorlist {
+  public:
+	// Member types
+	using value_type = T;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using const_reference = const value_type &;
+
+	static constexpr size_type default_segment_capacity = 256;
+
+  private:
+	using __segment = xorlist<T, Allocator>;
+	using __segment_pointer = std::shared_ptr<__segment>;
+	using __table = xorlist<__segment_pointer>;
+
+	std::shared_ptr<__table> _table;
+	size_type _size = 0;
+	size_type _segment_capacity;
+	allocator_type _alloc;
+
+  public:
+	class const_iterator {
+		const cow_xorlist *_list = nullptr;
+		typename __table::iterator _segment;
+		typename __segment::iterator _it;
+
+		friend cow_xorlist;
+
+		const_iterator(const cow_xorlist *list, typename __table::iterator segment, typename __segment::iterator it)
+			: _list(list), _segment(segment), _it(it) {}
+
+	  public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T *;
+		using reference = const T &;
+
+		const_iterator() = default;
+
+		reference operator*() const { return *_it; }
+		pointer operator->() const { return std::addressof(*_it); }
+
+		const_iterator &operator++() {
+			if (++_it == (*_segment)->end())
+				*this = _list->__first(std::next(_segment));
+
+			return *this;
+		}
+
+		const_iterator operator++(int) {
+			const_iterator __tmp = *this;
+			++*this;
+			return __tmp;
+		}
+
+		friend bool operator==(const const_iterator &x, const const_iterator &y) noexcept {
+			return x._segment == y._segment && x._it == y._it;
+		}
+	};
+
+	/*
+	 * Constructs an empty list.
+	 * Exceptions: `std::invalid_argument` if `segment_capacity` is 0.
+	 */
+	explicit cow_xorlist(size_type segment_capacity = default_segment_capacity,
+						 const allocator_type &alloc = allocator_type())
+		: _table(std::make_shared<__table>()), _segment_capacity(segment_capacity), _alloc(alloc) {
+		if (segment_capacity == 0)
+			throw std::invalid_argument("cow_xorlist: segment_capacity must be positive");
+	}
+
+	template <class InputIt>
+	cow_xorlist(InputIt first, InputIt last, size_type segment_capacity = default_segment_capacity,
+				const allocator_type &alloc = allocator_type())
+		: cow_xorlist(segment_capacity, alloc) {
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+
+	cow_xorlist(std::initializer_list<value_type> init, size_type segment_capacity = default_segment_capacity,
+				const allocator_type &alloc = allocator_type())
+		: cow_xorlist(init.begin(), init.end(), segment_capacity, alloc) {}
+
+	// Copies share the storage; there is no move constructor, so that a moved-from list stays usable.
+	cow_xorlist(const cow_xorlist &) = default;
+	cow_xorlist &operator=(const cow_xorlist &) = default;
+
+	const_iterator begin() const noexcept { return __first(_table->begin()); }
+	const_iterator end() const noexcept { return const_iterator(this, _table->end(), {}); }
+
+	[[nodiscard]] bool empty() const noexcept { return _size == 0; }
+	size_type size() const noexcept { return _size; }
+
+	const_reference front() const { return _table->front()->front(); }
+	const_reference back() const { return _table->back()->back(); }
+
+	// Number of segments shared with other lists, i.e. that a mutation would have to clone.
+	size_type shared_segments() const noexcept {
+		if (_table.use_count() > 1)
+			return _table->size();
+
+		return static_cast<size_type>(std::count_if(_table->begin(), _table->end(),
+													[](const __segment_pointer &__s) { return __s.use_count() > 1; }));
+	}
+
+	/*
+	 * Appends `value`, cloning the back segment first if it is shared.
+	 * Complexity: Constant, plus the number of segments and the segment capacity if the storage is shared.
+	 */
+	void push_back(const value_type &value) {
+		__table &__t = __own_table();
+
+		if (__t.empty() || __t.back()->size() == _segment_capacity)
+			__t.push_back(std::make_shared<__segment>(_alloc));
+
+		__own(__t.back()).push_back(value);
+		++_size;
+	}
+
+	void push_front(const value_type &value) {
+		__table &__t = __own_table();
+
+		if (__t.empty() || __t.front()->size() == _segment_capacity)
+			__t.push_front(std::make_shared<__segment>(_alloc));
+
+		__own(__t.front()).push_front(value);
+		++_size;
+	}
+
+	// Calling `pop_back` on an empty list is undefined.
+	void pop_back() {
+		__table &__t = __own_table();
+
+		// a segment about to be emptied is dropped rather than cloned
+		if (__t.back()->size() == 1)
+			__t.pop_back();
+		else
+			__own(__t.back()).pop_back();
+
+		--_size;
+	}
+
+	// Calling `pop_front` on an empty list is undefined.
+	void pop_front() {
+		__table &__t = __own_table();
+
+		if (__t.front()->size() == 1)
+			__t.pop_front();
+		else
+			__own(__t.front()).pop_front();
+
+		--_size;
+	}
+
+	// Releases this list's share of the storage.
+	void clear() {
+		if (__unique(_table))
+			_table->clear();
+		else
+			_table = std::make_shared<__table>();
+
+		_size = 0;
+	}
+
+	/*
+	 * Inserts `value` before `pos`. A segment which grows past twice the capacity is split in two.
+	 * Return value: Iterator pointing to the inserted value.
+	 * Complexity: Linear in the segment capacity, plus the number of segments if the storage is shared.
+	 */
+	const_iterator insert(const_iterator pos, const value_type &value) {
+		if (pos == end()) {
+			push_back(value);
+			return const_iterator(this, std::prev(_table->end()), std::prev(_table->back()->end()));
+		}
+
+		auto [__seg, __it] = __own_position(pos);
+		__segment &__s = **__seg;
+		__it = __s.insert(__it, value);
+		++_size;
+
+		if (__s.size() <= 2 * _segment_capacity)
+			return const_iterator(this, __seg, __it);
+
+		// split, keeping the offset of the new element
+		const auto __offset = static_cast<size_type>(std::distance(__s.begin(), __it));
+		const auto __half = std::next(__s.begin(), static_cast<difference_type>(_segment_capacity));
+		__segment_pointer __second = std::make_shared<__segment>(_alloc);
+		__second->splice(__second->end(), __s, __half, __s.end());
+
+		// inserting after `__seg` leaves its predecessor, hence `__seg` itself, valid
+		const auto __next = _table->insert(std::next(__seg), std::move(__second));
+
+		if (__offset < _segment_capacity)
+			return const_iterator(this, __seg, std::next(__s.begin(), static_cast<difference_type>(__offset)));
+
+		const auto __rest = static_cast<difference_type>(__offset - _segment_capacity);
+		return const_iterator(this, __next, std::next((*__next)->begin(), __rest));
+	}
+
+	/*
+	 * Replaces the element at `pos` with `value`.
+	 * Complexity: Constant, plus the number of segments and the segment capacity if the storage is shared.
+	 */
+	void replace(const_iterator pos, const value_type &value) { *__own_position(pos).second = value; }
+
+	/*
+	 * Removes the element at `pos`. A segment left empty is removed.
+	 * Return value: Iterator following the removed element.
+	 * Complexity: Constant, plus the number of segments and the segment capacity if the storage is shared.
+	 */
+	const_iterator erase(const_iterator pos) {
+		auto [__seg, __it] = __own_position(pos);
+		__segment &__s = **__seg;
+		__it = __s.erase(__it);
+		--_size;
+
+		if (__s.empty())
+			return __first(_table->erase(__seg));
+
+		return __it == __s.end() ? __first(std::next(__seg)) : const_iterator(this, __seg, __it);
+	}
+
+	friend bool operator==(const cow_xorlist &lhs, const cow_xorlist &rhs) {
+		return lhs._size == rhs._size && (lhs._table == rhs._table || std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+  private:
+	const_iterator __first(typename __table::iterator __seg) const noexcept {
+		return __seg == _table->end() ? end() : const_iterator(this, __seg, (*__seg)->begin());
+	}
+
+	/*
+	 * Whether `__p` is the only owner of its object, which can then be mutated in place. `use_count` is a relaxed load:
+	 * the fence orders the mutation after the reads which the other owners made before they released their shares.
+	 */
+	template <class U> static bool __unique(const std::shared_ptr<U> &__p) noexcept {
+		if (__p.use_count() != 1)
+			return false;
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return true;
+	}
+
+	// Clones the table if it is shared; the segments stay shared.
+	__table &__own_table() {
+		if (!__unique(_table))
+			_table = std::make_shared<__table>(*_table);
+
+		return *_table;
+	}
+
+	// Clones the segment pointed to by `__s`, in an owned table, if it is shared.
+	__segment &__own(__segment_pointer &__s) {
+		if (!__unique(__s))
+			__s = std::make_shared<__segment>(*__s);
+
+		return *__s;
+	}
+
+	// Makes the table and the segment of `__pos` owned, and returns the equivalent position in them.
+	std::pair<typename __table::iterator, typename __segment::iterator> __own_position(const_iterator __pos) {
+		if (__unique(_table) && __unique(*__pos._segment))
+			return {__pos._segment, __pos._it};
+
+		const auto __k = std::distance(_table->begin(), __pos._segment);
+		const auto __i = std::distance((*__pos._segment)->begin(), __pos._it);
+		const auto __seg = std::next(__own_table().begin(), __k);
+
+		return {__seg, std::next(__own(*__seg).begin(), __i)};
+	}
+};
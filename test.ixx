@@ -1,10 +1,29 @@
 export module test;
 
 import <string>;
+import <filesystem>;
+import <fstream>;
 import <algorithm>;
 import <numeric>;
+import <stdexcept>;
 import <cassert>;
+import <cstring>;
+import <memory>;
+import <ranges>;
+import <thread>;
+import <vector>;
+import cow_xorlist;
 import xorlist;
+import xor_checkpoint;
+import xor_external_sort;
+import xor_generator;
+import xor_linked_hash_map;
+import xor_mmap_loader;
+import xor_lru_cache;
+import xor_sorted_index;
+import xor_spill_list;
+import xor_unordered_map;
+import xorlist_builder;
 
 export void constructor() {
 	xorlist<std::string> words1{"the", "frogurt", "is", "also", "cursed"};
@@ -384,6 +403,8 @@ export void splice() {
 
 	assert(list1 == xorlist<int>({1, 2, 10, 20, 30, 40, 50, 3, 4, 5}) && list2.empty());
 
+	// `it` was invalidated, 50 now preceding 3
+	it = std::next(list1.begin(), 7);
 	list2.splice(list2.begin(), list1, it, list1.end());
 
 	assert(list1 == xorlist<int>({1, 2, 10, 20, 30, 40, 50}) && list2 == xorlist<int>({3, 4, 5}));
@@ -397,6 +418,25 @@ export void remove() {
 
 	auto count2 = l.remove_if([](int n) { return n > 10; });
 	assert(l == xorlist<int>({2, 3, 10, -1}));
+
+	// a throwing predicate keeps the removals made before it threw, eager or lazy
+	for (const float ratio : {0.0f, 0.5f}) {
+		xorlist<int> m = {1, 2, 3, 4, 5, 6};
+		m.max_dead_ratio(ratio);
+
+		try {
+			m.remove_if([](int n) {
+				if (n == 5)
+					throw std::runtime_error("predicate");
+				return n % 2 == 0;
+			});
+		} catch (const std::runtime_error &) {
+		}
+
+		assert(m == xorlist<int>({1, 3, 5, 6}) && m.size() == 4);
+		m.purge();
+		assert(m.size() == 4 && std::distance(m.begin(), m.end()) == 4);
+	}
 }
 
 export void reverse() {
@@ -404,7 +444,7 @@ export void reverse() {
 
 	list.reverse();
 
-	assert(list == xorlist<int>({9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+	assert(list == xorlist<int>({4, 6, 2, 3, 1, 0, 9, 5, 7, 8}));
 }
 
 export void unique() {
@@ -418,6 +458,34 @@ export void unique() {
 	const auto count2 = c.unique([mod = 10](int x, int y) { return (x % mod) == (y % mod); });
 
 	assert(c == xorlist<int>({1, 2, 23, 2, 51, 2}) && count2 == 4);
+
+	// a throwing predicate keeps the duplicates removed before it threw
+	xorlist<int> d = {1, 11, 2, 12, 3, 13};
+
+	try {
+		d.unique([](int x, int y) {
+			if (y == 3)
+				throw std::runtime_error("predicate");
+			return x % 10 == y % 10;
+		});
+	} catch (const std::runtime_error &) {
+	}
+
+	assert(d == xorlist<int>({1, 2, 3, 13}) && d.size() == 4);
+}
+
+export void unique_unsorted() {
+	xorlist<int> c = {1, 2, 2, 3, 3, 2, 1, 1, 2};
+
+	const auto count1 = c.unique_unsorted();
+
+	assert(c == xorlist<int>({1, 2, 3}) && count1 == 6);
+
+	xorlist<int> d = {1, 2, 12, 23, 3, 2, 51, 1, 2, 2};
+	const auto count2 = d.unique_unsorted([](int x) { return std::hash<int>()(x % 10); },
+										  [](int x, int y) { return (x % 10) == (y % 10); });
+
+	assert(d == xorlist<int>({1, 2, 23}) && count2 == 7);
 }
 
 export void sort() {
@@ -426,6 +494,192 @@ export void sort() {
 	list.sort();
 
 	assert(list == xorlist<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+	list.sort(std::greater<int>());
+
+	assert(list == xorlist<int>({9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+
+	// stable
+	xorlist<std::pair<int, int>> pairs = {{1, 0}, {0, 1}, {1, 2}, {0, 3}};
+	pairs.sort([](const auto &a, const auto &b) { return a.first < b.first; });
+
+	assert((pairs == xorlist<std::pair<int, int>>({{0, 1}, {0, 3}, {1, 0}, {1, 2}})));
+}
+
+struct record {
+	int key, seq;
+
+	auto operator<=>(const record &) const = default;
+};
+
+export void external_merge_sort() {
+	xorlist<record> list;
+	for (int i = 0; i < 10000; ++i)
+		list.push_back({(i * 7919) % 100, i});
+
+	// a budget of a few hundred elements forces many runs, hence an intermediate merge pass
+	external_sort(list, [](record a, record b) { return a.key < b.key; }, std::filesystem::temp_directory_path(), 2048);
+
+	// stable: equal keys keep their original order
+	assert(list.size() == 10000 && std::is_sorted(list.begin(), list.end()));
+}
+
+export void insert_sorted() {
+	xorlist<int> c{1, 3, 5, 7};
+
+	// the finger follows the last insertion, left or right
+	assert(*c.insert_sorted(4) == 4 && *c.insert_sorted(6) == 6 && *c.insert_sorted(2) == 2);
+	assert(*c.insert_sorted(0) == 0 && *c.insert_sorted(8) == 8);
+	assert(c == xorlist<int>({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+	// erasing the finger drops it, and the next search starts from the back
+	c.pop_back();
+	assert(*c.insert_sorted(3) == 3 && c == xorlist<int>({0, 1, 2, 3, 3, 4, 5, 6, 7}));
+
+	xorlist<std::pair<int, int>> stable;
+	const auto by_first = [](const auto &a, const auto &b) { return a.first < b.first; };
+
+	for (int i = 0; i < 6; ++i)
+		stable.insert_sorted({i % 3, i}, by_first);
+
+	// equal elements go after their equivalents
+	assert((stable == xorlist<std::pair<int, int>>({{0, 0}, {0, 3}, {1, 1}, {1, 4}, {2, 2}, {2, 5}})));
+}
+
+export void insert_sorted_batch() {
+	xorlist<int> c{2, 4, 6, 8};
+	const int sorted[] = {0, 5, 5, 9};
+	const int shuffled[] = {7, 1, 4, 10, 3};
+
+	c.insert_sorted_batch(std::begin(sorted), std::end(sorted));
+	assert(c == xorlist<int>({0, 2, 4, 5, 5, 6, 8, 9}));
+
+	c.insert_sorted_batch(std::begin(shuffled), std::end(shuffled));
+	assert(c == xorlist<int>({0, 1, 2, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10}) && c.size() == 13);
+
+	xorlist<int> descending;
+	descending.insert_sorted_batch(std::begin(shuffled), std::end(shuffled), std::greater<int>());
+	assert(descending == xorlist<int>({10, 7, 4, 3, 1}));
+
+	// a comparison throwing while the batch is sorted leaves the list as it was
+	try {
+		descending.insert_sorted_batch(std::begin(shuffled), std::end(shuffled), [](int x, int y) {
+			if (x == 10 || y == 10)
+				throw std::runtime_error("comparison");
+			return x > y;
+		});
+	} catch (const std::runtime_error &) {
+	}
+
+	assert(descending == xorlist<int>({10, 7, 4, 3, 1}) && descending.size() == 5);
+}
+
+export void partial_sort_nth_element() {
+	xorlist<int> c{9, 4, 7, 1, 8, 2, 6, 3, 5, 0};
+
+	const auto mid = c.partial_sort(3);
+	assert(std::distance(c.begin(), mid) == 3 && *mid == 9);
+	assert(c == xorlist<int>({0, 1, 2, 9, 4, 7, 8, 6, 3, 5}));
+
+	// largest first
+	c.partial_sort(2, std::greater<int>());
+	assert(c.front() == 9 && *std::next(c.begin()) == 8 && c.size() == 10);
+	assert(c.partial_sort(100) == c.end() && std::is_sorted(c.begin(), c.end()));
+
+	xorlist<int> d{5, 1, 4, 2, 3};
+	const auto nth = d.nth_element(2);
+	assert(*nth == 3 && std::distance(d.begin(), nth) == 2);
+	assert(std::all_of(d.begin(), nth, [](int x) { return x < 3; }));
+	assert(std::all_of(nth, d.end(), [](int x) { return x >= 3; }));
+	// the rebuilt ring can be walked backwards
+	assert(*std::prev(d.end(), 5) == d.front());
+	assert(d.nth_element(5) == d.end() && d.size() == 5);
+
+	// a throwing comparison loses no element, whichever pass it interrupts
+	for (int limit = 10; limit < 60; limit += 5) {
+		xorlist<int> e{9, 4, 7, 1, 8, 2, 6, 3, 5, 0};
+		int calls = 0;
+
+		try {
+			e.partial_sort(4, [&](int x, int y) {
+				if (++calls == limit)
+					throw std::runtime_error("comparison");
+				return x < y;
+			});
+		} catch (const std::runtime_error &) {
+		}
+
+		std::vector<int> values(e.begin(), e.end());
+		std::sort(values.begin(), values.end());
+		assert(e.size() == 10 && values == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+	}
+}
+
+export void partition() {
+	xorlist<int> c{1, 2, 3, 4, 5, 6, 7};
+
+	const auto it = c.stable_partition([](int x) { return x % 2 == 0; });
+	assert(c == xorlist<int>({2, 4, 6, 1, 3, 5, 7}) && *it == 1 && std::distance(c.begin(), it) == 3);
+	assert(c.partition([](int x) { return x > 10; }) == c.begin() && c.partition([](int) { return true; }) == c.end());
+
+	xorlist<int> small{0}, large;
+	c.partition_into([](int x) { return x < 4; }, small, large);
+	assert(c.empty() && small == xorlist<int>({0, 2, 1, 3}) && large == xorlist<int>({4, 6, 5, 7}));
+	assert(small.size() == 4 && large.size() == 4);
+}
+
+export void distribute() {
+	xorlist<int> c{31, 12, 23, 11, 32, 13, 21, 22, 33};
+	xorlist<int> buckets[4];
+
+	// LSD radix sort: distribute by units, gather, distribute by tens, gather
+	for (const int radix : {1, 10}) {
+		c.distribute([=](int x) { return x / radix % 10; }, buckets);
+		assert(c.empty());
+
+		for (xorlist<int> &bucket : buckets)
+			c.splice(c.end(), bucket);
+	}
+
+	assert(c == xorlist<int>({11, 12, 13, 21, 22, 23, 31, 32, 33}) && c.size() == 9);
+
+	bool thrown = false;
+
+	try {
+		c.distribute([](int x) { return x / 10 + 2; }, buckets);
+	} catch (const std::out_of_range &) {
+		thrown = true;
+	}
+
+	// the elements before the faulty one were moved, the others stay
+	assert(thrown && buckets[3] == xorlist<int>({11, 12, 13}) && c.front() == 21 && c.size() == 6);
+}
+
+export void set_operations() {
+	{
+		xorlist<int> a{1, 2, 2, 4}, b{2, 3, 4, 4}, out;
+		const auto rejected = a.set_union_into(b, out);
+		assert(out == xorlist<int>({1, 2, 2, 3, 4, 4}) && rejected == xorlist<int>({2, 4}) && a.empty() && b.empty());
+	}
+	{
+		xorlist<int> a{1, 2, 2, 4}, b{2, 3, 4, 4}, out;
+		const auto rejected = a.set_intersection_into(b, out);
+		assert(out == xorlist<int>({2, 4}) && rejected.size() == 6);
+	}
+	{
+		xorlist<int> a{1, 2, 2, 4}, b{2, 3, 4, 4}, out{0};
+		a.set_difference_into(b, out);
+		assert(out == xorlist<int>({0, 1, 2}) && out.size() == 3);
+	}
+	{
+		xorlist<int> a{4, 2, 2, 1}, b{4, 4, 3, 2}, out;
+		a.set_symmetric_difference_into(b, out, std::greater<int>());
+		assert(out == xorlist<int>({4, 3, 2, 1}));
+	}
+
+	xorlist<int> a{1, 3, 5}, b{2, 3, 6};
+	a.merge(b, std::less<int>());
+	assert(a == xorlist<int>({1, 2, 3, 3, 5, 6}) && b.empty() && a.size() == 6);
 }
 
 export void operator_equivalent_threeway_comparison() {
@@ -471,3 +725,430 @@ export void erase_erase_if() {
 
 	assert(cnt == xorlist<int>({1, 5, 7, 9}) && erased == 5);
 }
+
+// Tombstones
+
+export void purge() {
+	xorlist<int> c{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+	c.max_dead_ratio(0.5f);
+	assert(c.max_dead_ratio() == 0.5f);
+
+	c.erase(c.begin());
+	const auto erased = c.remove_if([](int n) { return n % 3 == 0; });
+
+	assert(c == xorlist<int>({1, 2, 4, 5, 7, 8}) && erased == 3);
+	assert(c.front() == 1 && c.back() == 8);
+	assert(std::accumulate(c.rbegin(), c.rend(), 0) == 27);
+
+	c.purge();
+	assert(c == xorlist<int>({1, 2, 4, 5, 7, 8}));
+
+	// crossing the threshold compacts on the spot, disabling the mode purges
+	c.erase(c.begin(), std::next(c.begin(), 4));
+	assert(c == xorlist<int>({7, 8}));
+
+	c.max_dead_ratio(0.0f);
+	c.erase(c.begin());
+	assert(c == xorlist<int>({8}) && c.size() == 1);
+}
+
+// Linked hash map
+
+export void linked_hash_map() {
+	xor_linked_hash_map<std::string, int> m{{"one", 1}, {"two", 2}, {"three", 3}};
+
+	assert(m.size() == 3 && m.at("two") == 2 && m.contains("three") && !m.contains("four"));
+	assert(m.front().first == "one" && m.back().first == "three");
+
+	m["four"] = 4;
+	assert(!m.insert({"one", 10}).second && m["one"] == 1);
+	assert(!m.insert_or_assign("one", 11).second && m["one"] == 11);
+
+	// erasing the head and a middle entry keeps the neighbours reachable in O(1)
+	assert(m.erase("one") == 1 && m.erase("three") == 1 && m.erase("five") == 0);
+	assert(m.size() == 2 && m.front().first == "two" && m.back().first == "four");
+	assert(m.erase(m.find("four")) == m.end() && m.at("two") == 2);
+
+	for (int i = 0; i < 1000; ++i)
+		m.try_emplace(std::to_string(i), i);
+
+	assert(m.size() == 1001 && m.load_factor() <= m.max_load_factor());
+	assert(erase_if(m, [](const auto &e) { return e.second % 2 == 1; }) == 500);
+	assert(m.size() == 501 && m.begin()->first == "two" && m.at("998") == 998 && !m.contains("999"));
+
+	auto copy = m;
+	auto moved = std::move(m);
+	assert(copy == moved && moved.erase("two") == 1 && moved.begin()->first == "0");
+}
+
+export void lru_cache() {
+	xor_lru_cache<int, std::string> cache(3);
+
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.put(3, "three");
+
+	// 1 becomes the most recently used, so 2 is evicted
+	assert(cache.get(1) != nullptr && *cache.get(1) == "one");
+	cache.put(4, "four");
+	assert(cache.size() == 3 && !cache.contains(2) && cache.get(2) == nullptr);
+
+	// peek does not refresh 3, touch refreshes 1 and 4
+	assert(*cache.peek(3) == "three");
+	const int burst[] = {1, 1, 1, 4, 5, 4};
+	assert(cache.touch_many(std::begin(burst), std::end(burst)) == 5);
+
+	cache.put(6, "six");
+	assert(!cache.contains(3) && cache.contains(1) && cache.contains(4));
+
+	cache.put(1, "uno");
+	assert(*cache.get(1) == "uno" && cache.size() == 3 && cache.erase(6) && !cache.erase(6));
+}
+
+// Unordered map
+
+export void unordered_map() {
+	xor_unordered_map<int, std::string> m{{1, "one"}, {2, "two"}, {3, "three"}};
+
+	assert(m.size() == 3 && m.at(2) == "two" && m.contains(3) && !m.contains(4));
+	assert(!m.insert({1, "uno"}).second && m[1] == "one");
+	assert(!m.insert_or_assign(1, "uno").second && m[1] == "uno");
+
+	// a single bucket forces long chains, erased from the head, the tail and the middle
+	struct collide {
+		std::size_t operator()(int) const { return 0; }
+	};
+	xor_unordered_map<int, int, collide> chain(2);
+	chain.max_load_factor(1000.0f);
+
+	for (int i = 0; i < 100; ++i)
+		chain.try_emplace(i, i);
+
+	assert(chain.bucket_count() == 2 && chain.bucket_size(0) == 100);
+	assert(chain.erase(0) == 1 && chain.erase(99) == 1 && chain.erase(50) == 1 && chain.erase(50) == 0);
+	assert(chain.size() == 97 && chain.find(49)->second == 49 && chain.find(51)->second == 51);
+	assert(erase_if(chain, [](const auto &e) { return e.first % 2 == 0; }) == 48 && chain.size() == 49);
+
+	for (int i = 0; i < 10000; ++i)
+		m.try_emplace(i, std::to_string(i));
+
+	assert(m.size() == 10000 && m.load_factor() <= m.max_load_factor() && m.at(4) == "4");
+	assert(std::distance(m.begin(), m.end()) == 10000);
+
+	auto copy = m;
+	auto moved = std::move(m);
+	assert(copy.size() == 10000 && moved.erase(1) == 1 && moved.size() == 9999);
+	assert(m.empty() && m.insert({7, "seven"}).second && m.at(7) == "seven");
+	// the copy draws from slabs of its own, so that it can be used on another thread
+	assert(copy.get_allocator() != moved.get_allocator() && copy.get_allocator().slab_count() > 0);
+}
+
+// Sorted index
+
+export void sorted_index() {
+	xor_sorted_index<int> s(std::less<int>(), 2);
+
+	for (int i = 0; i < 100; ++i)
+		s.insert((i * 37) % 100);
+
+	assert(s.size() == 100 && std::is_sorted(s.begin(), s.end()));
+	assert(*s.lower_bound(42) == 42 && *s.upper_bound(42) == 43 && s.find(100) == s.end());
+
+	s.insert(42);
+	s.insert(42);
+	assert(s.count(42) == 3 && s.erase(42) == 3 && !s.contains(42) && s.size() == 99);
+	assert(*s.erase(s.find(0)) == 1 && *s.begin() == 1 && s.erase(99) == 1 && s.size() == 97);
+
+	// the released list keeps its order, and can be indexed again
+	auto list = s.release();
+	assert(s.empty() && list.size() == 97 && list.front() == 1 && list.back() == 98);
+
+	xor_sorted_index<int> t(std::move(list));
+	assert(t.size() == 97 && *t.lower_bound(42) == 43);
+
+	auto copy = t;
+	auto moved = std::move(t);
+	assert(std::equal(copy.begin(), copy.end(), moved.begin(), moved.end()) && *moved.insert(0) == 0);
+	assert(*moved.begin() == 0 && moved.lower_bound(-1) == moved.begin());
+
+	// erasing most elements rebalances the runs, which keeps both the index small and the searches right
+	xor_sorted_index<int> u(std::less<int>(), 8);
+
+	for (int i = 0; i < 1000; ++i)
+		u.insert((i * 37) % 1000);
+
+	for (int i = 0; i < 1000; ++i)
+		if (const int v = (i * 337) % 1000; v % 10 != 0)
+			assert(u.erase(v) == 1);
+
+	assert(u.size() == 100 && u.index_size() <= 2 * u.size() / u.stride());
+
+	for (int i = 0; i <= 990; ++i)
+		assert(u.contains(i) == (i % 10 == 0) && *u.lower_bound(i) == (i + 9) / 10 * 10);
+}
+
+// Memory-mapped loader
+
+export void mmap_loader() {
+	const auto path = std::filesystem::temp_directory_path() / "xorlist_mmap_loader.txt";
+	std::ofstream(path) << "alpha\nbeta\n\ngamma\n";
+
+	// a copy has slabs of its own but the same anchor, hence the mapping, which outlives the original list
+	const mapped_lines copy = [&] {
+		const mapped_lines lines = load_lines(path);
+		assert(lines.size() == 4 && lines.front() == "alpha" && *std::next(lines.begin(), 2) == "");
+		assert(lines.back() == "gamma");
+		return mapped_lines(lines);
+	}();
+	assert(copy.size() == 4 && copy.back() == "gamma");
+	assert(copy.get_allocator() != mapped_lines(copy).get_allocator());
+
+	const mapped_lines records = load_records(path, 8);
+	assert(records.size() == 3 && records.front() == "alpha\nbe" && records.back() == "a\n");
+
+	std::filesystem::remove(path);
+}
+
+// Parallel builder
+
+export void builder() {
+	std::vector<std::pair<int, int>> chunks;
+	for (int i = 0; i < 100; ++i)
+		chunks.emplace_back(i * 1000, (i + 1) * 1000);
+
+	// chunks finish out of order, but are linked in submission order
+	const auto list = parallel_build<int>(
+		chunks.begin(), chunks.end(),
+		[](std::pair<int, int> chunk, xorlist<int> &out) {
+			for (int i = chunk.first; i < chunk.second; ++i)
+				out.push_back(i);
+		},
+		4);
+	assert(list.size() == 100000 && std::is_sorted(list.begin(), list.end()) && list.back() == 99999);
+
+	// fill functions only need to be movable
+	xorlist_builder<int> owning(2);
+	owning.submit([value = std::make_unique<int>(42)](xorlist<int> &out) { out.push_back(*value); });
+	assert(owning.finish() == xorlist<int>({42}));
+
+	xorlist_builder<int> failing(2);
+	failing.submit([](xorlist<int> &out) { out.push_back(1); });
+	failing.submit([](xorlist<int> &) { throw std::runtime_error("parse error"); });
+
+	bool thrown = false;
+	try {
+		failing.finish();
+	} catch (const std::runtime_error &) {
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+// Generators
+
+generator<int> iota(int n) {
+	for (int i = 0; i < n; ++i)
+		co_yield i;
+}
+
+export void generators() {
+	// lazy stages compose without intermediate lists
+	xorlist<int> squares;
+	squares.append_range(iota(6) | std::views::transform([](int x) { return x * x; }));
+	assert((squares == xorlist<int>{0, 1, 4, 9, 16, 25}));
+
+	xorlist<int> even;
+	even.append_range(drain(squares) | std::views::filter([](int x) { return x % 2 == 0; }));
+	assert(squares.empty() && (even == xorlist<int>{0, 4, 16}));
+
+	xor_channel<int> channel;
+	std::thread producer([&] {
+		for (int i = 0; i < 1000; ++i)
+			channel.push(i);
+		channel.close();
+	});
+
+	int expected = 0;
+	for (int x : channel.async_drain())
+		assert(x == expected++);
+
+	producer.join();
+	assert(expected == 1000);
+}
+
+// Spill list
+
+export void spill_list() {
+	// room for 1000 resident elements, in segments of 100
+	xor_spill_list<long> list(1000 * (sizeof(long) + sizeof(void *)), 100);
+
+	for (long i = 0; i < 100000; ++i)
+		list.push_back(i);
+	assert(list.size() == 100000 && list.resident_size() <= 1200 && list.spilled_segments() > 900);
+
+	// iteration pages segments back in, spilling others
+	long expected = 0;
+	for (long x : list)
+		assert(x == expected++);
+	assert(expected == 100000 && list.resident_size() <= 1200);
+
+	// modifications survive a round trip to disk
+	*list.begin() = -1;
+	for (auto it = std::next(list.begin(), 50000); it != list.end(); ++it)
+		;
+	assert(*list.begin() == -1);
+
+	list.pop_front();
+	assert(list.front() == 1 && list.back() == 99999 && list.size() == 99999);
+
+	// a moved-from list is empty and usable
+	xor_spill_list<long> moved = std::move(list);
+	assert(moved.size() == 99999 && moved.front() == 1 && list.empty() && list.resident_size() == 0);
+	assert(list.spilled_segments() == 0 && list.begin() == list.end());
+	list.push_back(7);
+	assert(list.front() == 7 && list.size() == 1);
+
+	list = std::move(moved);
+	assert(list.size() == 99999 && list.back() == 99999 && moved.empty());
+}
+
+// Delta checkpoints
+
+export void checkpoint() {
+	const auto dir = std::filesystem::temp_directory_path();
+	const std::vector<std::filesystem::path> files = {dir / "xorlist_base.ckpt", dir / "xorlist_delta.ckpt"};
+
+	xor_checkpointed_list<long> list(100);
+	for (long i = 0; i < 10000; ++i)
+		list.push_back(i);
+	list.checkpoint(files[0]);
+
+	// appends only dirty the segments they touch
+	for (long i = 0; i < 150; ++i)
+		list.push_back(-i);
+	list.pop_front();
+	list.replace(std::next(list.begin(), 5000), 42);
+	assert(list.dirty_segments() == 4);
+
+	list.checkpoint(files[1]);
+	assert(list.dirty_segments() == 0);
+	assert(std::filesystem::file_size(files[1]) * 10 < std::filesystem::file_size(files[0]));
+
+	const auto restored = xor_checkpointed_list<long>::restore(files, 100);
+	assert(std::equal(restored.begin(), restored.end(), list.begin(), list.end()));
+
+	for (const auto &file : files)
+		std::filesystem::remove(file);
+}
+
+// Copy-on-write list
+
+export void cow() {
+	cow_xorlist<int> config(10);
+	for (int i = 0; i < 1000; ++i)
+		config.push_back(i);
+
+	// copies share everything until they are modified
+	const cow_xorlist<int> snapshot = config;
+	assert(snapshot == config && config.shared_segments() == 100);
+
+	config.replace(std::next(config.begin(), 555), -1);
+	assert(config.shared_segments() == 99 && *std::next(snapshot.begin(), 555) == 555);
+
+	config.erase(config.begin());
+	config.insert(config.begin(), 42);
+	assert(config.front() == 42 && snapshot.front() == 0 && snapshot.size() == 1000 && config.size() == 1000);
+	assert(std::equal(std::next(snapshot.begin()), snapshot.end(), std::next(config.begin()),
+					  [](int x, int y) { return x == y || y == -1; }));
+}
+
+// Allocation guarantees
+
+struct allocation_counts {
+	std::size_t allocations = 0; // ever made
+	std::size_t live = 0;
+};
+
+// Counts allocations, and poisons freed blocks, so that a node used after being freed no longer holds its value.
+template <class T> struct counting_allocator {
+	using value_type = T;
+
+	allocation_counts *counts;
+
+	explicit counting_allocator(allocation_counts &counts) noexcept : counts(&counts) {}
+
+	template <class U> counting_allocator(const counting_allocator<U> &other) noexcept : counts(other.counts) {}
+
+	T *allocate(std::size_t n) {
+		T *const p = std::allocator<T>().allocate(n);
+		++counts->allocations;
+		++counts->live;
+		return p;
+	}
+
+	void deallocate(T *p, std::size_t n) noexcept {
+		--counts->live;
+		std::memset(static_cast<void *>(p), 0xdd, n * sizeof(T));
+		std::allocator<T>().deallocate(p, n);
+	}
+
+	template <class U> bool operator==(const counting_allocator<U> &other) const noexcept {
+		return counts == other.counts;
+	}
+};
+
+// Counts the copies and moves of elements, by construction or assignment.
+struct tracked {
+	static inline std::size_t transfers = 0;
+
+	int value;
+
+	tracked(int value = 0) : value(value) {}
+	tracked(const tracked &other) : value(other.value) { ++transfers; }
+	tracked(tracked &&other) noexcept : value(other.value) { ++transfers; }
+
+	tracked &operator=(const tracked &other) {
+		value = other.value;
+		++transfers;
+		return *this;
+	}
+
+	tracked &operator=(tracked &&other) noexcept { return *this = other; }
+
+	friend bool operator==(const tracked &x, const tracked &y) noexcept { return x.value == y.value; }
+	friend auto operator<=>(const tracked &x, const tracked &y) noexcept { return x.value <=> y.value; }
+};
+
+// Relinking operations neither allocate nor touch the elements, which is what a node container is used for.
+export void allocation_free_operations() {
+	using list = xorlist<tracked, counting_allocator<tracked>>;
+
+	allocation_counts counts;
+	const counting_allocator<tracked> alloc(counts);
+	list a(alloc), b(alloc), odd(alloc), even(alloc);
+
+	for (int i = 0; i < 100; ++i)
+		(i % 3 == 0 ? a : b).emplace_back((i * 37) % 100);
+
+	const std::size_t nodes = counts.allocations;
+	tracked::transfers = 0;
+
+	a.splice(a.end(), b);
+	b.splice(b.begin(), a, std::next(a.begin(), 5));
+	b.splice(b.end(), a, std::next(a.begin(), 10), std::next(a.begin(), 40));
+	a.reverse();
+	a.partition_into([](const tracked &x) { return x.value % 2 != 0; }, odd, even);
+	odd.merge(even, [](const tracked &x, const tracked &y) { return x.value % 2 < y.value % 2; });
+	const std::size_t removed = odd.remove(tracked(37)) + odd.remove_if([](const tracked &x) { return x.value < 10; });
+	assert(counts.allocations == nodes && counts.live == nodes - removed && tracked::transfers == 0);
+
+	// sort relinks the nodes and allocates nothing
+	odd.sort();
+	assert(counts.allocations == nodes && counts.live == nodes - removed && tracked::transfers == 0);
+	assert(std::is_sorted(odd.begin(), odd.end()) && odd.size() + b.size() + removed == 100);
+
+	odd.clear();
+	b.clear();
+	assert(counts.live == 0);
+}
@@ -0,0 +1,404 @@
+/*
+ * https://en.wikipedia.org/wiki/Application_checkpointing
+ */
+export module xor_checkpoint;
+
+import <cstddef>;
+import <cstdint>;
+import <cstring>;
+
+import <filesystem>;
+import <fstream>;
+import <iterator>;
+import <memory>;
+import <span>;
+import <stdexcept>;
+import <string>;
+import <type_traits>;
+import <unordered_map>;
+import <utility>;
+import <vector>;
+
+import xorlist;
+
+/**
+ - [x] explicit xor_checkpointed_list(size_type segment_capacity);
+ - [x] const_iterator begin() const noexcept; const_iterator end() const noexcept;
+ - [x] const_reference front() const; const_reference back() const;
+ - [x] size_type size() const noexcept; bool empty() const noexcept; size_type dirty_segments() const noexcept;
+ - [x] void push_back(const value_type& value); void push_front(const value_type& value);
+ - [x] void pop_back(); void pop_front();
+ - [x] void replace(const_iterator pos, const value_type& value);
+ - [x] const_iterator erase(const_iterator pos);
+ - [x] void checkpoint(const std::filesystem::path& path, bool full);
+ - [x] static xor_checkpointed_list restore(std::span<const std::filesystem::path> files, size_type segment_capacity);
+ */
+
+inline constexpr char __checkpoint_magic[8] = {'X', 'O', 'R', 'C', 'K', 'P', 'T', '\0'};
+inline constexpr std::uint32_t __checkpoint_version = 1;
+
+// Fixed-size header of a checkpoint file, followed by the link patches, then by the segment records.
+struct __checkpoint_header {
+	char _magic[8];
+	std::uint32_t _version;
+	std::uint32_t _full; // 1 if the file holds the whole list rather than the changes since the previous one
+	std::uint64_t _sequence;
+	std::uint64_t _value_size;
+	std::uint64_t _next_id;
+	std::uint64_t _size; // number of elements of the list once the file is applied
+	std::uint64_t _patches;
+	std::uint64_t _segments;
+};
+
+// Change of the order of the segments; id 0 stands for the ends of the list.
+struct __link_patch {
+	enum class op : std::uint64_t { link_after, unlink };
+
+	op _op;
+	std::uint64_t _id;
+	std::uint64_t _prev; // for `link_after`
+};
+
+// Header of a segment record, followed by its elements.
+struct __segment_header {
+	std::uint64_t _id;
+	std::uint64_t _size;
+};
+
+/*
+ * List stored as a `xorlist` of segments of up to `segment_capacity` consecutive elements, each a `xorlist` of its
+ * own, which can be checkpointed incrementally. Every modification marks the segment it touches as dirty, and every
+ * segment created or removed appends a link patch to a log. A delta checkpoint writes only the dirty segments and the
+ * log since the previous checkpoint; for a mostly append-only list, that is the last segment or so, whatever the size
+ * of the list. A full checkpoint writes everything and can start a new chain of deltas.
+ * `restore` rebuilds the list from a full checkpoint followed by the deltas taken after it, in order.
+ * Notes: `T` must be trivially copyable, since segments are written and read back as raw bytes, in the native byte
+ * order.
+ */
+export template <class T> class xor_checkpointed_list {
+	static_assert(std::is_trivially_copyable_v<T>, "xor_checkpointed_list: elements are written as raw bytes");
+
+  public:
+	// Member types
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using const_reference = const value_type &;
+
+	static constexpr size_type default_segment_capacity = 4096;
+
+  private:
+	struct __segment {
+		std::uint64_t _id = 0;
+		xorlist<T> _elements;
+		bool _dirty = true;
+	};
+
+	using __segment_list = xorlist<__segment>;
+
+	mutable __segment_list _segments; // mutable for `const_iterator`, which only exposes the elements as `const`
+	std::vector<__link_patch> _patches;  // since the last checkpoint
+	size_type _size = 0;
+	size_type _segment_capacity;
+	std::uint64_t _next_id = 1;
+	std::uint64_t _sequence = 0; // of the next checkpoint
+
+  public:
+	class const_iterator {
+		const xor_checkpointed_list *_list = nullptr;
+		typename __segment_list::iterator _segment;
+		typename xorlist<T>::iterator _it;
+
+		friend xor_checkpointed_list;
+
+		const_iterator(const xor_checkpointed_list *list, typename __segment_list::iterator segment,
+					   typename xorlist<T>::iterator it)
+			: _list(list), _segment(segment), _it(it) {}
+
+	  public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T *;
+		using reference = const T &;
+
+		const_iterator() = default;
+
+		reference operator*() const { return *_it; }
+		pointer operator->() const { return std::addressof(*_it); }
+
+		const_iterator &operator++() {
+			if (++_it == _segment->_elements.end())
+				*this = _list->__first(std::next(_segment));
+
+			return *this;
+		}
+
+		const_iterator operator++(int) {
+			const_iterator __tmp = *this;
+			++*this;
+			return __tmp;
+		}
+
+		friend bool operator==(const const_iterator &x, const const_iterator &y) noexcept {
+			return x._segment == y._segment && x._it == y._it;
+		}
+	};
+
+	/*
+	 * Constructs an empty list.
+	 * Exceptions: `std::invalid_argument` if `segment_capacity` is 0.
+	 */
+	explicit xor_checkpointed_list(size_type segment_capacity = default_segment_capacity)
+		: _segment_capacity(segment_capacity) {
+		if (segment_capacity == 0)
+			throw std::invalid_argument("xor_checkpointed_list: segment_capacity must be positive");
+	}
+
+	const_iterator begin() const noexcept { return __first(_segments.begin()); }
+	const_iterator end() const noexcept { return const_iterator(this, _segments.end(), {}); }
+
+	[[nodiscard]] bool empty() const noexcept { return _size == 0; }
+	size_type size() const noexcept { return _size; }
+
+	const_reference front() const { return _segments.front()._elements.front(); }
+	const_reference back() const { return _segments.back()._elements.back(); }
+
+	// Number of segments that the next delta checkpoint would write.
+	size_type dirty_segments() const noexcept {
+		size_type __n = 0;
+
+		for (const __segment &__s : _segments)
+			__n += __s._dirty;
+
+		return __n;
+	}
+
+	void push_back(const value_type &value) {
+		if (_segments.empty() || _segments.back()._elements.size() == _segment_capacity)
+			__link_segment(_segments.end());
+
+		__segment &__s = _segments.back();
+		__s._elements.push_back(value);
+		__s._dirty = true;
+		++_size;
+	}
+
+	void push_front(const value_type &value) {
+		if (_segments.empty() || _segments.front()._elements.size() == _segment_capacity)
+			__link_segment(_segments.begin());
+
+		__segment &__s = _segments.front();
+		__s._elements.push_front(value);
+		__s._dirty = true;
+		++_size;
+	}
+
+	// Calling `pop_back` on an empty list is undefined.
+	void pop_back() { erase(__last()); }
+
+	// Calling `pop_front` on an empty list is undefined.
+	void pop_front() { erase(begin()); }
+
+	/*
+	 * Replaces the element at `pos` with `value`, marking its segment as dirty. Elements are not writable through
+	 * iterators, since such writes would escape the tracking.
+	 */
+	void replace(const_iterator pos, const value_type &value) {
+		*pos._it = value;
+		pos._segment->_dirty = true;
+	}
+
+	/*
+	 * Removes the element at `pos`. A segment left empty is removed, which is logged.
+	 * Return value: Iterator following the removed element.
+	 * Complexity: Constant.
+	 */
+	const_iterator erase(const_iterator pos) {
+		const auto __next = pos._segment->_elements.erase(pos._it);
+		pos._segment->_dirty = true;
+		--_size;
+
+		if (!pos._segment->_elements.empty())
+			return __next == pos._segment->_elements.end() ? __first(std::next(pos._segment))
+														   : const_iterator(this, pos._segment, __next);
+
+		_patches.push_back({__link_patch::op::unlink, pos._segment->_id, 0});
+
+		return __first(_segments.erase(pos._segment));
+	}
+
+	/*
+	 * Writes a checkpoint to `path`, atomically: the file is written under a temporary name, then renamed.
+	 * Parameters:
+	 *   - path: file to write
+	 *   - full: whether to write the whole list, which starts a new chain of deltas, rather than the changes since the
+	 *     previous checkpoint; the first checkpoint is always full
+	 * Complexity: Linear in the number of segments, plus the size of the written ones.
+	 * Exceptions: `std::ios_base::failure` if the file cannot be written, in which case the changes are kept for the
+	 * next checkpoint.
+	 */
+	void checkpoint(const std::filesystem::path &path, bool full = false) {
+		full = full || _sequence == 0;
+
+		std::vector<__link_patch> __order;
+		const std::vector<__link_patch> &__patches = full ? __order : _patches;
+		std::uint64_t __written = 0;
+
+		if (full) {
+			std::uint64_t __prev = 0;
+
+			for (const __segment &__s : _segments)
+				__order.push_back({__link_patch::op::link_after, __s._id, std::exchange(__prev, __s._id)});
+		}
+
+		for (const __segment &__s : _segments)
+			__written += full || __s._dirty;
+
+		const std::filesystem::path __tmp = path.string() + ".tmp";
+
+		{
+			std::ofstream __out;
+			__out.exceptions(std::ios::failbit | std::ios::badbit);
+			__out.open(__tmp, std::ios::binary | std::ios::trunc);
+
+			__checkpoint_header __h{};
+			std::memcpy(__h._magic, __checkpoint_magic, sizeof(__h._magic));
+			__h._version = __checkpoint_version;
+			__h._full = full;
+			__h._sequence = _sequence;
+			__h._value_size = sizeof(T);
+			__h._next_id = _next_id;
+			__h._size = _size;
+			__h._patches = __patches.size();
+			__h._segments = __written;
+
+			__write(__out, &__h, 1);
+			__write(__out, __patches.data(), __patches.size());
+
+			std::vector<T> __buffer;
+
+			for (const __segment &__s : _segments)
+				if (full || __s._dirty) {
+					const __segment_header __sh{__s._id, __s._elements.size()};
+					__buffer.assign(__s._elements.begin(), __s._elements.end());
+					__write(__out, &__sh, 1);
+					__write(__out, __buffer.data(), __buffer.size());
+				}
+		}
+
+		std::filesystem::rename(__tmp, path);
+
+		for (__segment &__s : _segments)
+			__s._dirty = false;
+
+		_patches.clear();
+		++_sequence;
+	}
+
+	/*
+	 * Rebuilds a list from a full checkpoint followed by the delta checkpoints taken after it, in order. Files before
+	 * the last full one in `files` are read but superseded. Checkpoints can then be taken on the restored list, as
+	 * deltas of the last file.
+	 * Exceptions: `std::runtime_error` if a file is not a checkpoint of `T`, or if the files do not form a chain.
+	 */
+	static xor_checkpointed_list restore(std::span<const std::filesystem::path> files,
+										 size_type segment_capacity = default_segment_capacity) {
+		xor_checkpointed_list __list(segment_capacity);
+
+		// the order of the segments as a ring of ids, 0 being the sentinel: id -> (prev, next)
+		std::unordered_map<std::uint64_t, std::pair<std::uint64_t, std::uint64_t>> __links{{0, {0, 0}}};
+		std::unordered_map<std::uint64_t, std::vector<T>> __contents;
+		bool __started = false;
+
+		for (const std::filesystem::path &__path : files) {
+			std::ifstream __in;
+			__in.exceptions(std::ios::failbit | std::ios::badbit);
+			__in.open(__path, std::ios::binary);
+
+			__checkpoint_header __h;
+			__read(__in, &__h, 1);
+
+			if (std::memcmp(__h._magic, __checkpoint_magic, sizeof(__h._magic)) != 0 ||
+				__h._version != __checkpoint_version || __h._value_size != sizeof(T))
+				throw std::runtime_error("xor_checkpointed_list: not a checkpoint of this type: " + __path.string());
+
+			if (__h._full) {
+				__links = {{0, {0, 0}}};
+				__contents.clear();
+			} else if (!__started || __h._sequence != __list._sequence)
+				throw std::runtime_error("xor_checkpointed_list: checkpoint out of sequence: " + __path.string());
+
+			std::vector<__link_patch> __patches(__h._patches);
+			__read(__in, __patches.data(), __patches.size());
+
+			for (const __link_patch &__p : __patches)
+				if (__p._op == __link_patch::op::link_after) {
+					const std::uint64_t __next = __links.at(__p._prev).second;
+					__links[__p._id] = {__p._prev, __next};
+					__links.at(__p._prev).second = __p._id;
+					__links.at(__next).first = __p._id;
+				} else {
+					const auto [__prev, __next] = __links.at(__p._id);
+					__links.at(__prev).second = __next;
+					__links.at(__next).first = __prev;
+					__links.erase(__p._id);
+					__contents.erase(__p._id);
+				}
+
+			for (std::uint64_t __i = 0; __i < __h._segments; ++__i) {
+				__segment_header __sh;
+				__read(__in, &__sh, 1);
+
+				std::vector<T> &__values = __contents[__sh._id];
+				__values.resize(__sh._size);
+				__read(__in, __values.data(), __values.size());
+			}
+
+			__started = true;
+			__list._sequence = __h._sequence + 1;
+			__list._next_id = __h._next_id;
+			__list._size = __h._size;
+		}
+
+		for (std::uint64_t __id = __links.at(0).second; __id != 0; __id = __links.at(__id).second) {
+			__segment &__s = __list._segments.emplace_back();
+			__s._id = __id;
+			__s._dirty = false;
+
+			std::vector<T> &__values = __contents.at(__id);
+			__s._elements.append_range(__values);
+			std::vector<T>().swap(__values);
+		}
+
+		return __list;
+	}
+
+  private:
+	const_iterator __first(typename __segment_list::iterator __segment) const noexcept {
+		return __segment == _segments.end() ? end() : const_iterator(this, __segment, __segment->_elements.begin());
+	}
+
+	const_iterator __last() const noexcept {
+		const auto __segment = std::prev(_segments.end());
+		return const_iterator(this, __segment, std::prev(__segment->_elements.end()));
+	}
+
+	// Links a new segment before `__pos` and logs it.
+	void __link_segment(typename __segment_list::iterator __pos) {
+		const std::uint64_t __prev = __pos == _segments.begin() ? 0 : std::prev(__pos)->_id;
+		_patches.reserve(_patches.size() + 1);
+
+		__segment &__s = *_segments.emplace(__pos);
+		__s._id = _next_id++;
+		_patches.push_back({__link_patch::op::link_after, __s._id, __prev});
+	}
+
+	template <class U> static void __write(std::ofstream &__out, const U *__data, std::size_t __n) {
+		__out.write(reinterpret_cast<const char *>(__data), static_cast<std::streamsize>(__n * sizeof(U)));
+	}
+
+	template <class U> static void __read(std::ifstream &__in, U *__data, std::size_t __n) {
+		__in.read(reinterpret_cast<char *>(__data), static_cast<std::streamsize>(__n * sizeof(U)));
+	}
+};
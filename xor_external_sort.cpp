@@ -0,0 +1,231 @@
+/*
+ * https://en.wikipedia.org/wiki/External_sorting
+ * https://en.wikipedia.org/wiki/K-way_merge_algorithm
+ */
+module;
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+export module xor_external_sort;
+
+import <cerrno>;
+import <cstddef>;
+import <cstdio>;
+
+import <algorithm>;
+import <filesystem>;
+import <functional>;
+import <iterator>;
+import <memory>;
+import <string>;
+import <system_error>;
+import <type_traits>;
+import <vector>;
+
+import xorlist;
+
+/**
+ - [x] template <class T, class Allocator, class Compare> void external_sort(xorlist<T, Allocator>& list, Compare comp,
+ const std::filesystem::path& tmp_dir, std::size_t memory_budget);
+ */
+
+// Runs merged at once; more runs are merged in several passes.
+inline constexpr std::size_t __max_fan_in = 64;
+
+/*
+ * Sorted run in an anonymous temporary file, written then read back sequentially through a block buffer of its own,
+ * so that the disk only sees large sequential transfers. The block is freed while the run waits to be merged, so that
+ * only the runs being written or merged hold one.
+ */
+template <class T> class __run_file {
+	std::FILE *_file;
+	std::vector<T> _block;
+	std::size_t _block_size;
+	std::size_t _pos = 0;  // next element of the block to read
+	std::size_t _used = 0; // elements in the block
+
+  public:
+	__run_file(const std::filesystem::path &dir, std::size_t block_size) : _block_size(block_size) {
+		std::string path = (dir / "xorlist_run_XXXXXX").string();
+		const int fd = ::mkstemp(path.data());
+
+		if (fd < 0)
+			throw std::system_error(errno, std::generic_category(), "external_sort: cannot create " + path);
+
+		::unlink(path.c_str());
+		_file = ::fdopen(fd, "w+b");
+
+		if (_file == nullptr) {
+			const int error = errno;
+			::close(fd);
+			throw std::system_error(error, std::generic_category(), "external_sort: cannot open " + path);
+		}
+
+		// the block is the buffer
+		std::setvbuf(_file, nullptr, _IONBF, 0);
+		_block.resize(_block_size);
+	}
+
+	__run_file(const __run_file &) = delete;
+	__run_file &operator=(const __run_file &) = delete;
+
+	~__run_file() { std::fclose(_file); }
+
+	void push(const T &value) {
+		if (_used == _block.size())
+			flush();
+
+		_block[_used++] = value;
+	}
+
+	void flush() {
+		if (_used != 0 && std::fwrite(_block.data(), sizeof(T), _used, _file) != _used)
+			throw std::system_error(errno, std::generic_category(), "external_sort: cannot write run");
+
+		_used = 0;
+	}
+
+	// Flushes the pending elements and frees the block until `rewind`.
+	void seal() {
+		flush();
+		std::vector<T>().swap(_block);
+	}
+
+	// Flushes the pending elements and reads the run from its beginning.
+	void rewind() {
+		flush();
+		std::rewind(_file);
+		_block.resize(_block_size);
+		_pos = _used = 0;
+		__fill();
+	}
+
+	// Current element, or `nullptr` past the end of the run.
+	const T *peek() const noexcept { return _pos < _used ? std::addressof(_block[_pos]) : nullptr; }
+
+	void pop() {
+		if (++_pos == _used)
+			__fill();
+	}
+
+  private:
+	void __fill() {
+		_used = std::fread(_block.data(), sizeof(T), _block.size(), _file);
+		_pos = 0;
+
+		if (_used == 0 && std::ferror(_file))
+			throw std::system_error(errno, std::generic_category(), "external_sort: cannot read run");
+	}
+};
+
+/*
+ * Merges `[first, last)` into `sink`, which is called with each element in order. Ties go to the earliest run, which
+ * holds the earliest elements of the list, so that the merge is stable.
+ */
+template <class T, class Compare, class Sink>
+void __merge_runs(std::unique_ptr<__run_file<T>> *first, std::unique_ptr<__run_file<T>> *last, Compare &comp,
+				  Sink sink) {
+	std::vector<std::size_t> heap;
+
+	for (std::unique_ptr<__run_file<T>> *run = first; run != last; ++run) {
+		(*run)->rewind();
+
+		if ((*run)->peek() != nullptr)
+			heap.push_back(static_cast<std::size_t>(run - first));
+	}
+
+	// max-heap on "is merged after", i.e. min-heap on the merge order
+	const auto after = [&](std::size_t a, std::size_t b) {
+		const T &x = *first[a]->peek(), &y = *first[b]->peek();
+		return comp(y, x) || (!comp(x, y) && a > b);
+	};
+
+	std::make_heap(heap.begin(), heap.end(), after);
+
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), after);
+		__run_file<T> &run = *first[heap.back()];
+
+		sink(*run.peek());
+		run.pop();
+
+		if (run.peek() != nullptr)
+			std::push_heap(heap.begin(), heap.end(), after);
+		else
+			heap.pop_back();
+	}
+}
+
+/*
+ * Sorts `list` with respect to `comp`, stably, using no more than about `memory_budget` bytes of working memory on top
+ * of the list itself. Runs of the list that fit in the budget are cut off its front, sorted in memory with
+ * `xorlist::sort` and written to anonymous temporary files in `tmp_dir`, their nodes being freed as soon as they are
+ * written; the runs are then merged back into the list, at most 64 at a time, by a k-way merge reading each of them
+ * through a block buffer. Only the runs being merged, and the run an intermediate pass writes, hold a block, so at
+ * most 65 blocks exist at once whatever the number of runs. Since nodes are freed before the merge allocates them
+ * again, the list never exists twice in memory. A list that fits in the budget is simply sorted in memory.
+ * Parameters:
+ *   - list: list to sort
+ *   - comp: comparison function object which returns `true` if the first argument is ordered before the second
+ *   - tmp_dir: directory of the run files, which are deleted when the sort returns, even by an exception
+ *   - memory_budget: working memory in bytes, estimated as `sizeof(T) + sizeof(void*)` per element of a run
+ * Complexity: `O(N log N)` comparisons; each element is written and read once per merge pass, and there is a single
+ * pass unless there are more than 64 runs.
+ * Exceptions: `std::system_error` if a run file cannot be created, written or read. If an exception is thrown, the
+ * elements that were written to runs and not yet merged back are lost.
+ * Notes: `T` must be trivially copyable, since runs are written and read back as raw bytes.
+ */
+export template <class T, class Allocator, class Compare = std::less<T>>
+void external_sort(xorlist<T, Allocator> &list, Compare comp = Compare(),
+				   const std::filesystem::path &tmp_dir = std::filesystem::temp_directory_path(),
+				   std::size_t memory_budget = std::size_t(256) << 20) {
+	static_assert(std::is_trivially_copyable_v<T>, "external_sort: runs are written as raw bytes");
+
+	// a run costs its nodes, which `sort` relinks without allocating, plus a block buffer when written
+	const std::size_t run_size = std::max<std::size_t>(memory_budget / (sizeof(T) + sizeof(void *)), 1);
+	const std::size_t block_size = std::max<std::size_t>(memory_budget / ((__max_fan_in + 1) * sizeof(T)), 1);
+
+	if (list.size() <= run_size) {
+		list.sort(comp);
+		return;
+	}
+
+	std::vector<std::unique_ptr<__run_file<T>>> runs;
+
+	while (!list.empty()) {
+		xorlist<T, Allocator> run(list.get_allocator());
+		run.splice(run.end(), list, list.begin(),
+				   std::next(list.begin(), static_cast<std::ptrdiff_t>(std::min(run_size, list.size()))));
+		run.sort(comp);
+
+		__run_file<T> &file = *runs.emplace_back(std::make_unique<__run_file<T>>(tmp_dir, block_size));
+
+		for (const T &value : run)
+			file.push(value);
+
+		file.seal();
+	}
+
+	// intermediate passes merge consecutive runs, which keeps the merge stable
+	while (runs.size() > __max_fan_in) {
+		std::vector<std::unique_ptr<__run_file<T>>> merged;
+
+		for (std::size_t i = 0; i < runs.size(); i += __max_fan_in) {
+			const std::size_t last = std::min(i + __max_fan_in, runs.size());
+			__run_file<T> &file = *merged.emplace_back(std::make_unique<__run_file<T>>(tmp_dir, block_size));
+
+			__merge_runs(runs.data() + i, runs.data() + last, comp, [&](const T &value) { file.push(value); });
+			file.seal();
+
+			// free the disk space of the merged runs right away
+			for (std::size_t j = i; j < last; ++j)
+				runs[j].reset();
+		}
+
+		runs = std::move(merged);
+	}
+
+	__merge_runs(runs.data(), runs.data() + runs.size(), comp, [&](const T &value) { list.push_back(value); });
+}
@@ -0,0 +1,264 @@
+/*
+ * https://en.cppreference.com/w/cpp/language/coroutines
+ * https://en.cppreference.com/w/cpp/coroutine/generator
+ */
+export module xor_generator;
+
+import <cstddef>;
+
+import <condition_variable>;
+import <coroutine>;
+import <exception>;
+import <iterator>;
+import <memory>;
+import <mutex>;
+import <ranges>;
+import <type_traits>;
+import <utility>;
+
+import xorlist;
+
+/**
+ - [x] template <class T> class generator; // subset of C++23 std::generator
+ - [x] template <class T, class Allocator> generator<T> drain(xorlist<T, Allocator>& list);
+ - [x] void push(const value_type& value); void push(value_type&& value);
+ - [x] template <class... Args> void emplace(Args&&... args);
+ - [x] void push_batch(list_type&& batch);
+ - [x] void close();
+ - [x] generator<T> async_drain();
+ - [x] lock_stats lock_statistics();
+ */
+
+/*
+ * Lazy input range of the values yielded by a coroutine, which runs until its next `co_yield` each time the range is
+ * advanced. Its reference type is `T&&`, or `T` if `T` is a reference, so that e.g. `xorlist::append_range` moves the
+ * yielded values. A generator can be traversed only once, and is a view, so it composes with `std::views`.
+ */
+export template <class T> class generator : public std::ranges::view_base {
+  public:
+	using value_type = std::remove_cvref_t<T>;
+	using reference = std::conditional_t<std::is_reference_v<T>, T, T &&>;
+
+	class promise_type {
+		std::add_pointer_t<reference> _value = nullptr;
+
+		friend generator;
+
+	  public:
+		generator get_return_object() noexcept {
+			return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		std::suspend_always final_suspend() const noexcept { return {}; }
+
+		// the yielded object outlives the suspension, which ends the full-expression of the `co_yield`
+		std::suspend_always yield_value(reference value) noexcept {
+			_value = std::addressof(value);
+			return {};
+		}
+
+		// lvalues yielded as rvalue references are copied into the awaiter, which lives in the coroutine frame
+		auto yield_value(const value_type &value)
+			requires std::is_rvalue_reference_v<reference>
+		{
+			struct __awaiter : std::suspend_always {
+				value_type _copy;
+
+				void await_suspend(std::coroutine_handle<promise_type> __h) noexcept {
+					__h.promise()._value = std::addressof(_copy);
+				}
+			};
+
+			return __awaiter{{}, value};
+		}
+
+		void return_void() const noexcept {}
+
+		// rethrown to the caller of `begin()` or `operator++`, the coroutine being then done
+		void unhandled_exception() { throw; }
+
+		template <class U> void await_transform(U &&) = delete;
+	};
+
+	class iterator {
+		std::coroutine_handle<promise_type> _coroutine;
+
+		friend generator;
+
+		explicit iterator(std::coroutine_handle<promise_type> coroutine) noexcept : _coroutine(coroutine) {}
+
+	  public:
+		using value_type = generator::value_type;
+		using difference_type = std::ptrdiff_t;
+
+		reference operator*() const noexcept { return static_cast<reference>(*_coroutine.promise()._value); }
+
+		iterator &operator++() {
+			_coroutine.resume();
+			return *this;
+		}
+
+		void operator++(int) { ++*this; }
+
+		friend bool operator==(const iterator &it, std::default_sentinel_t) noexcept { return it._coroutine.done(); }
+	};
+
+  private:
+	std::coroutine_handle<promise_type> _coroutine;
+
+	explicit generator(std::coroutine_handle<promise_type> coroutine) noexcept : _coroutine(coroutine) {}
+
+  public:
+	generator(generator &&other) noexcept : _coroutine(std::exchange(other._coroutine, nullptr)) {}
+
+	generator &operator=(generator other) noexcept {
+		std::swap(_coroutine, other._coroutine);
+		return *this;
+	}
+
+	~generator() {
+		if (_coroutine)
+			_coroutine.destroy();
+	}
+
+	/*
+	 * Runs the coroutine until its first `co_yield`. The behavior is undefined if `begin()` is called more than once.
+	 * Exceptions: Any exception thrown by the coroutine.
+	 */
+	iterator begin() {
+		_coroutine.resume();
+		return iterator(_coroutine);
+	}
+
+	std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+/*
+ * Yields the elements of `list` from front to back, moving each of them out and destroying its node as soon as the
+ * consumer advances. A stage of a pipeline can so hand its output to the next one while releasing it, instead of
+ * keeping both in memory. `list` must outlive the traversal.
+ * Complexity: Constant per element.
+ */
+export template <class T, class Allocator> generator<T> drain(xorlist<T, Allocator> &list) {
+	while (!list.empty()) {
+		co_yield std::move(list.front());
+		list.pop_front();
+	}
+}
+
+/*
+ * Unbounded single-consumer channel backed by a `xorlist`. Producers push elements, or whole lists in O(1), from any
+ * thread; the consumer takes everything pending in one O(1) splice, then yields it without holding the lock, so a
+ * batch costs one lock acquisition on each side. `lock_statistics()` reports how many of those had to wait.
+ * Notes: Elements are allocated by the producers and freed by the consumer, so the allocator must be thread-safe.
+ */
+export template <class T, class Allocator = std::allocator<T>> class xor_channel {
+  public:
+	using value_type = T;
+	using allocator_type = Allocator;
+	using list_type = xorlist<T, Allocator>;
+
+	struct lock_stats {
+		std::size_t acquisitions = 0; // by `push_batch`, `close` and each batch of `async_drain`
+		std::size_t contended = 0;	  // acquisitions which found the lock held by another thread
+	};
+
+  private:
+	list_type _pending;
+	std::mutex _mutex;
+	std::condition_variable _ready; // an element was pushed, or the channel was closed
+	lock_stats _stats;				// only updated while locked
+	bool _closed = false;
+
+  public:
+	explicit xor_channel(const allocator_type &alloc = allocator_type()) : _pending(alloc) {}
+
+	xor_channel(const xor_channel &) = delete;
+	xor_channel &operator=(const xor_channel &) = delete;
+
+	/*
+	 * Pushes an element constructed from `args...`. The node is created before locking the channel.
+	 * Exceptions: If an exception is thrown, this function has no effect.
+	 */
+	template <class... Args> void emplace(Args &&...args) {
+		list_type __one(_pending.get_allocator());
+		__one.emplace_back(std::forward<Args>(args)...);
+		push_batch(std::move(__one));
+	}
+
+	void push(const value_type &value) { emplace(value); }
+	void push(value_type &&value) { emplace(std::move(value)); }
+
+	/*
+	 * Pushes the elements of `batch`, in order, and empties it. `batch` must have an allocator equal to the one of the
+	 * channel.
+	 * Complexity: Constant.
+	 */
+	void push_batch(list_type &&batch) {
+		{
+			const std::unique_lock lock = __lock();
+			_pending.splice(_pending.end(), batch);
+		}
+
+		_ready.notify_one();
+	}
+
+	// Signals that nothing more will be pushed: `async_drain` ends once the pending elements are consumed.
+	void close() {
+		{
+			const std::unique_lock lock = __lock();
+			_closed = true;
+		}
+
+		_ready.notify_all();
+	}
+
+	/*
+	 * Yields the elements pushed into the channel, in order, as they arrive, until it is closed and empty. Between two
+	 * batches, the consumer blocks until a producer pushes or closes. Elements are moved out and their nodes freed as
+	 * the consumer advances.
+	 */
+	generator<T> async_drain() {
+		list_type __batch(_pending.get_allocator());
+
+		for (;;) {
+			{
+				std::unique_lock lock = __lock();
+				_ready.wait(lock, [&] { return _closed || !_pending.empty(); });
+
+				if (_pending.empty())
+					co_return;
+
+				__batch.splice(__batch.end(), _pending);
+			}
+
+			while (!__batch.empty()) {
+				co_yield std::move(__batch.front());
+				__batch.pop_front();
+			}
+		}
+	}
+
+	/*
+	 * Returns the number of lock acquisitions so far, and how many of them had to wait for another thread. Waking up
+	 * in `async_drain` relocks without being counted.
+	 */
+	lock_stats lock_statistics() {
+		std::lock_guard lock(_mutex);
+		return _stats;
+	}
+
+  private:
+	std::unique_lock<std::mutex> __lock() {
+		std::unique_lock lock(_mutex, std::try_to_lock);
+
+		if (!lock.owns_lock()) {
+			lock.lock();
+			++_stats.contended;
+		}
+
+		++_stats.acquisitions;
+		return lock;
+	}
+};
@@ -0,0 +1,489 @@
+/*
+ * https://docs.oracle.com/javase/8/docs/api/java/util/LinkedHashMap.html
+ * https://en.wikipedia.org/wiki/Linear_probing
+ */
+export module xor_linked_hash_map;
+
+import <cstddef>;
+import <cstdint>;
+
+import <algorithm>;
+import <bit>;
+import <functional>;
+import <initializer_list>;
+import <memory>;
+import <stdexcept>;
+import <tuple>;
+import <utility>;
+import <vector>;
+
+import xorlist;
+
+/**
+ - [x] xor_linked_hash_map();
+ - [x] explicit xor_linked_hash_map(size_type bucket_count, const hasher& hash, const key_equal& equal,
+ const allocator_type& alloc);
+ - [x] xor_linked_hash_map(const xor_linked_hash_map&);
+ - [x] xor_linked_hash_map(xor_linked_hash_map&&) noexcept;
+ - [x] xor_linked_hash_map(initializer_list<value_type>);
+ - [x] iterator begin() noexcept; iterator end() noexcept;
+ - [x] bool empty() const noexcept; size_type size() const noexcept;
+ - [x] void clear() noexcept;
+ - [x] template <class... Args> pair<iterator, bool> try_emplace(const key_type& k, Args&&... args);
+ - [x] pair<iterator, bool> insert(const value_type& value);
+ - [x] template <class M> pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj);
+ - [x] iterator erase(const_iterator pos);
+ - [x] iterator move_to_back(iterator pos);
+ - [x] size_type erase(const key_type& key);
+ - [x] mapped_type& at(const key_type& key);
+ - [x] mapped_type& operator[](const key_type& key);
+ - [x] iterator find(const key_type& key);
+ - [x] bool contains(const key_type& key) const;
+ - [x] float load_factor() const noexcept; float max_load_factor() const noexcept; void max_load_factor(float ml);
+ - [x] void rehash(size_type count); void reserve(size_type count);
+ - [x] hasher hash_function() const; key_equal key_eq() const;
+ */
+
+/*
+ * Hash map that iterates in insertion order. Entries are the nodes of a `xorlist`, so the order costs a single link
+ * word per node, and they are indexed by an open-addressing (linear probing) table of list positions. Lookup,
+ * insertion and erasure are O(1) on average.
+ * An entry's position is its node together with its predecessor, since a XOR-linked node can only be unlinked once one
+ * of its neighbours is known; whenever a node is unlinked, the slot of its successor is refreshed. A slot is thus two
+ * words, and with the table kept between 3/8 and 3/4 full, the index costs 2.7 to 5.3 words per entry on top of the
+ * single link: 3.7 to 6.3 words in all. A Java-style linked hash map, whose doubly linked nodes are indexed by a table
+ * of one-word node pointers with the same load, costs 2 links plus 1.3 to 2.7 words, i.e. 3.3 to 4.7 words per entry.
+ * This design therefore uses more memory than that baseline: the word saved on the link is spent, and more, on the
+ * predecessor each slot must hold.
+ * Notes: As with `xorlist`, an iterator is invalidated when the element preceding it changes.
+ */
+export template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+				 class Allocator = std::allocator<std::pair<const Key, T>>>
+class xor_linked_hash_map {
+  public:
+	// Member types
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using allocator_type = Allocator;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+	using iterator = typename xorlist<value_type, Allocator>::iterator;
+	using const_iterator = typename xorlist<value_type, Allocator>::const_iterator;
+
+  private:
+	using __list = xorlist<value_type, Allocator>;
+	using __slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<iterator>;
+
+	static constexpr std::size_t __npos = static_cast<std::size_t>(-1);
+	static constexpr int __min_bits = 3;
+
+	__list _entries;							  // insertion order
+	std::vector<iterator, __slot_allocator> _slots; // a default-constructed iterator marks an empty slot
+	int _bits = 0;								  // `_slots.size() == 1 << _bits`, or no table at all
+	float _max_load_factor = 0.75f;
+	[[no_unique_address]] hasher _hash;
+	[[no_unique_address]] key_equal _equal;
+
+	/* Member functions */
+
+  public:
+	/*
+	 * Default constructor. Constructs an empty container without allocating.
+	 * Complexity: Constant
+	 */
+	xor_linked_hash_map() = default;
+
+	/*
+	 * Constructs an empty container with room for at least `bucket_count` entries before a rehash.
+	 * Parameters:
+	 *   - bucket_count: minimal number of entries to reserve room for
+	 *   - hash: hash function to use
+	 *   - equal: comparison function to use for all key comparisons of this container
+	 *   - alloc: allocator to use for all memory allocations of this container
+	 * Complexity: Linear in `bucket_count`
+	 */
+	explicit xor_linked_hash_map(size_type bucket_count, const hasher &hash = hasher(),
+								 const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type())
+		: _entries(alloc), _slots(__slot_allocator(alloc)), _hash(hash), _equal(equal) {
+		reserve(bucket_count);
+	}
+
+	/*
+	 * Constructs the container with the contents of the initializer list `init`. If multiple elements have the same
+	 * key, only the first one is inserted.
+	 * Complexity: Linear in size of `init` on average
+	 */
+	xor_linked_hash_map(std::initializer_list<value_type> init) {
+		reserve(init.size());
+
+		for (const value_type &value : init)
+			insert(value);
+	}
+
+	/*
+	 * Copy constructor. Copies the entries in order, then indexes the copies.
+	 * Complexity: Linear in size of `other`
+	 */
+	xor_linked_hash_map(const xor_linked_hash_map &other)
+		: _entries(other._entries), _max_load_factor(other._max_load_factor), _hash(other._hash),
+		  _equal(other._equal) {
+		__rehash(other._bits);
+	}
+
+	/*
+	 * Move constructor. The nodes are spliced, so iterators to `other` now refer into `*this`.
+	 * Complexity: Constant
+	 */
+	xor_linked_hash_map(xor_linked_hash_map &&other) noexcept
+		: _entries(std::move(other._entries)), _slots(std::move(other._slots)), _bits(std::exchange(other._bits, 0)),
+		  _max_load_factor(other._max_load_factor), _hash(std::move(other._hash)), _equal(std::move(other._equal)) {
+		other._slots.clear();
+
+		// the first entry's predecessor was the sentinel of `other`
+		if (!empty())
+			__reslot(begin());
+	}
+
+	xor_linked_hash_map &operator=(const xor_linked_hash_map &other) {
+		if (this != std::addressof(other))
+			*this = xor_linked_hash_map(other);
+
+		return *this;
+	}
+
+	xor_linked_hash_map &operator=(xor_linked_hash_map &&other) noexcept {
+		if (this != std::addressof(other)) {
+			clear();
+			_entries.splice(_entries.end(), other._entries);
+			_slots = std::move(other._slots);
+			_bits = std::exchange(other._bits, 0);
+			_max_load_factor = other._max_load_factor;
+			_hash = std::move(other._hash);
+			_equal = std::move(other._equal);
+			other._slots.clear();
+
+			if (!empty())
+				__reslot(begin());
+		}
+
+		return *this;
+	}
+
+	allocator_type get_allocator() const noexcept { return _entries.get_allocator(); }
+
+	/* Iterators, in insertion order */
+
+	iterator begin() noexcept { return _entries.begin(); }
+	const_iterator begin() const noexcept { return _entries.begin(); }
+	const_iterator cbegin() const noexcept { return _entries.cbegin(); }
+	iterator end() noexcept { return _entries.end(); }
+	const_iterator end() const noexcept { return _entries.end(); }
+	const_iterator cend() const noexcept { return _entries.cend(); }
+
+	/*
+	 * Returns the oldest (first inserted) entry. Calling `front` on an empty container causes undefined behavior.
+	 * Complexity: Constant
+	 */
+	reference front() { return _entries.front(); }
+	const_reference front() const { return _entries.front(); }
+
+	/*
+	 * Returns the newest (last inserted) entry. Calling `back` on an empty container causes undefined behavior.
+	 * Complexity: Constant
+	 */
+	reference back() { return _entries.back(); }
+	const_reference back() const { return _entries.back(); }
+
+	/* Capacity */
+
+	[[nodiscard]] bool empty() const noexcept { return _entries.empty(); }
+
+	size_type size() const noexcept { return _entries.size(); }
+
+	/* Modifiers */
+
+	/*
+	 * Erases all elements from the container. The table keeps its capacity.
+	 * Complexity: Linear in the size of the container and in the number of slots
+	 */
+	void clear() noexcept {
+		_entries.clear();
+		std::fill(_slots.begin(), _slots.end(), iterator());
+	}
+
+	/*
+	 * If a key equivalent to `key` already exists, does nothing. Otherwise appends an entry constructed in place from
+	 * `key` and `args...`.
+	 * Return value: A pair of the iterator to the entry with key `key` and `true` if the insertion took place.
+	 * Complexity: Amortized constant on average, linear in the size of the container when a rehash occurs
+	 */
+	template <class... Args> std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+		return __try_emplace(key, std::forward<Args>(args)...);
+	}
+
+	template <class... Args> std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+		return __try_emplace(std::move(key), std::forward<Args>(args)...);
+	}
+
+	/*
+	 * Appends `value` if the container doesn't already contain an entry with an equivalent key.
+	 * Return value: A pair of the iterator to the entry with the key of `value` and `true` if the insertion took place.
+	 * Complexity: Amortized constant on average
+	 */
+	std::pair<iterator, bool> insert(const value_type &value) { return try_emplace(value.first, value.second); }
+
+	std::pair<iterator, bool> insert(value_type &&value) {
+		return try_emplace(std::move(const_cast<key_type &>(value.first)), std::move(value.second));
+	}
+
+	/*
+	 * If a key equivalent to `key` already exists, assigns `std::forward<M>(obj)` to its mapped value without changing
+	 * its position in the order. Otherwise appends a new entry.
+	 * Return value: A pair of the iterator to the entry with key `key` and `true` if the insertion took place.
+	 * Complexity: Amortized constant on average
+	 */
+	template <class M> std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+		auto result = try_emplace(key, std::forward<M>(obj));
+
+		if (!result.second)
+			result.first->second = std::forward<M>(obj);
+
+		return result;
+	}
+
+	/*
+	 * Removes the entry at `pos`, unlinking its node in constant time.
+	 * Return value: Iterator following the removed entry.
+	 * Complexity: Constant on average
+	 */
+	iterator erase(const_iterator pos) {
+		__erase_slot(__find_slot(pos->first));
+
+		const iterator next = _entries.erase(pos);
+
+		if (next != end())
+			__reslot(next);
+
+		return next;
+	}
+
+	/*
+	 * Removes the entry with a key equivalent to `key`, if any.
+	 * Return value: Number of elements removed (0 or 1).
+	 * Complexity: Constant on average
+	 */
+	size_type erase(const key_type &key) {
+		const std::size_t i = __find_slot(key);
+
+		if (i == __npos)
+			return 0;
+
+		erase(const_iterator(_slots[i]));
+
+		return 1;
+	}
+
+	/*
+	 * Moves the entry at `pos` to the back of the order, as if it had just been inserted. This is what turns the
+	 * insertion order into an access order.
+	 * Return value: Iterator to the moved entry.
+	 * Complexity: Constant on average
+	 */
+	iterator move_to_back(iterator pos) {
+		if (std::next(pos) == end())
+			return pos;
+
+		// the positions of the moved entry and of its successor change; the one of its predecessor does not
+		const bool front = pos == begin();
+		const iterator before = front ? end() : std::prev(pos);
+
+		_entries.splice(end(), _entries, pos);
+		__reslot(front ? begin() : std::next(before));
+
+		const iterator moved = std::prev(end());
+		__reslot(moved);
+
+		return moved;
+	}
+
+	/* Lookup */
+
+	/*
+	 * Returns a reference to the mapped value of the entry with key equivalent to `key`.
+	 * Exceptions: `std::out_of_range` if the container does not have an entry with the specified key.
+	 * Complexity: Constant on average
+	 */
+	mapped_type &at(const key_type &key) {
+		const std::size_t i = __find_slot(key);
+
+		if (i == __npos)
+			throw std::out_of_range("xor_linked_hash_map::at: key not found");
+
+		return _slots[i]->second;
+	}
+
+	const mapped_type &at(const key_type &key) const { return const_cast<xor_linked_hash_map &>(*this).at(key); }
+
+	/*
+	 * Returns a reference to the value mapped to `key`, appending a value-initialized entry if no such key exists.
+	 * Complexity: Amortized constant on average
+	 */
+	mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+
+	mapped_type &operator[](key_type &&key) { return try_emplace(std::move(key)).first->second; }
+
+	/*
+	 * Finds the entry with key equivalent to `key`.
+	 * Return value: Iterator to the entry, or `end()` if no such entry is found.
+	 * Complexity: Constant on average
+	 */
+	iterator find(const key_type &key) {
+		const std::size_t i = __find_slot(key);
+
+		return i == __npos ? end() : _slots[i];
+	}
+
+	const_iterator find(const key_type &key) const { return const_cast<xor_linked_hash_map &>(*this).find(key); }
+
+	size_type count(const key_type &key) const { return __find_slot(key) != __npos; }
+
+	bool contains(const key_type &key) const { return __find_slot(key) != __npos; }
+
+	/* Hash policy */
+
+	float load_factor() const noexcept { return _slots.empty() ? 0.0f : float(size()) / float(_slots.size()); }
+
+	float max_load_factor() const noexcept { return _max_load_factor; }
+
+	/*
+	 * Sets the load factor above which the table grows. Linear probing degrades quickly past 0.9, so larger values are
+	 * clamped.
+	 */
+	void max_load_factor(float ml) {
+		_max_load_factor = std::clamp(ml, 0.125f, 0.875f);
+		reserve(size());
+	}
+
+	size_type bucket_count() const noexcept { return _slots.size(); }
+
+	/* Observers */
+
+	hasher hash_function() const { return _hash; }
+
+	key_equal key_eq() const { return _equal; }
+
+	/*
+	 * Rebuilds the table with at least `count` slots, and at least enough to hold `size()` entries.
+	 * Complexity: Linear in the size of the container and in the number of slots
+	 */
+	void rehash(size_type count) {
+		count = std::max<size_type>(count, static_cast<size_type>(float(size()) / _max_load_factor) + 1);
+		__rehash(std::max<int>(__min_bits, std::bit_width(count - 1)));
+	}
+
+	/*
+	 * Makes room for `count` entries without further rehashing.
+	 */
+	void reserve(size_type count) {
+		if (count > 0 && float(count) > _max_load_factor * float(_slots.size()))
+			rehash(static_cast<size_type>(float(count) / _max_load_factor) + 1);
+	}
+
+  private:
+	// Fibonacci hashing: spreads identity-like hashes over the `_bits` high bits of the product.
+	std::size_t __home(const key_type &key) const noexcept {
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull) >>
+										(64 - _bits));
+	}
+
+	std::size_t __mask() const noexcept { return _slots.size() - 1; }
+
+	std::size_t __find_slot(const key_type &key) const {
+		if (_bits == 0)
+			return __npos;
+
+		for (std::size_t i = __home(key);; i = (i + 1) & __mask()) {
+			if (_slots[i] == iterator())
+				return __npos;
+			if (_equal(_slots[i]->first, key))
+				return i;
+		}
+	}
+
+	std::size_t __free_slot(const key_type &key) const noexcept {
+		std::size_t i = __home(key);
+
+		while (_slots[i] != iterator())
+			i = (i + 1) & __mask();
+
+		return i;
+	}
+
+	// Stores the current position of the entry `it`, whose predecessor changed.
+	void __reslot(iterator it) { _slots[__find_slot(it->first)] = it; }
+
+	// Backward-shift deletion: later members of the probe run are moved up so that no tombstone is needed.
+	void __erase_slot(std::size_t hole) noexcept {
+		for (std::size_t j = (hole + 1) & __mask(); _slots[j] != iterator(); j = (j + 1) & __mask())
+			if (((j - __home(_slots[j]->first)) & __mask()) >= ((j - hole) & __mask())) {
+				_slots[hole] = _slots[j];
+				hole = j;
+			}
+
+		_slots[hole] = iterator();
+	}
+
+	void __rehash(int bits) {
+		_bits = bits;
+		_slots.assign(bits == 0 ? 0 : std::size_t(1) << bits, iterator());
+
+		for (iterator it = begin(), e = end(); it != e; ++it)
+			_slots[__free_slot(it->first)] = it;
+	}
+
+	template <class K, class... Args> std::pair<iterator, bool> __try_emplace(K &&key, Args &&...args) {
+		if (const std::size_t i = __find_slot(key); i != __npos)
+			return {_slots[i], false};
+
+		reserve(size() + 1);
+
+		const iterator it =
+			_entries.emplace(end(), std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+							 std::forward_as_tuple(std::forward<Args>(args)...));
+		_slots[__free_slot(it->first)] = it;
+
+		return {it, true};
+	}
+};
+
+/* Non - member functions */
+
+/*
+ * Compares the contents of two maps, including the order of their entries.
+ * Complexity: Linear in the size of the maps
+ */
+export template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const xor_linked_hash_map<Key, T, Hash, KeyEqual, Alloc> &lhs,
+				const xor_linked_hash_map<Key, T, Hash, KeyEqual, Alloc> &rhs) {
+	return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+export template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Pred>
+typename xor_linked_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type
+erase_if(xor_linked_hash_map<Key, T, Hash, KeyEqual, Alloc> &c, Pred pred) {
+	typename xor_linked_hash_map<Key, T, Hash, KeyEqual, Alloc>::size_type count = 0;
+
+	for (auto it = c.begin(); it != c.end();)
+		if (pred(*it)) {
+			it = c.erase(it);
+			++count;
+		} else
+			++it;
+
+	return count;
+}
@@ -0,0 +1,160 @@
+/*
+ * https://en.wikipedia.org/wiki/Cache_replacement_policies#Least_recently_used_(LRU)
+ */
+export module xor_lru_cache;
+
+import <cstddef>;
+
+import <functional>;
+import <iterator>;
+import <memory>;
+import <stdexcept>;
+import <utility>;
+
+import xor_linked_hash_map;
+
+/**
+ - [x] explicit xor_lru_cache(size_type capacity);
+ - [x] mapped_type* get(const key_type& key);
+ - [x] const mapped_type* peek(const key_type& key) const;
+ - [x] template <class M> mapped_type& put(const key_type& key, M&& obj);
+ - [x] bool touch(const key_type& key);
+ - [x] template <class InputIt> size_type touch_many(InputIt first, InputIt last);
+ - [x] bool erase(const key_type& key);
+ - [x] bool contains(const key_type& key) const;
+ - [x] size_type size() const noexcept; size_type capacity() const noexcept; void clear() noexcept;
+ */
+
+/*
+ * Fixed-capacity cache evicting the least recently used entry. Recency is the order of a `xor_linked_hash_map`, i.e.
+ * a XOR-linked list whose index stores, for each key, the position needed to unlink its node in O(1). That position
+ * takes two words, which cancels the list pointer saved: an entry still costs less than in a `std::list` +
+ * `std::unordered_map` cache, but because the index holds neither nodes nor copies of the keys (see
+ * `xor_linked_hash_map` for measured figures).
+ * Iteration goes from the least to the most recently used entry.
+ */
+export template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+				 class Allocator = std::allocator<std::pair<const Key, T>>>
+class xor_lru_cache {
+  public:
+	// Member types
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using size_type = std::size_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using allocator_type = Allocator;
+	using const_iterator = typename xor_linked_hash_map<Key, T, Hash, KeyEqual, Allocator>::const_iterator;
+
+  private:
+	xor_linked_hash_map<Key, T, Hash, KeyEqual, Allocator> _entries; // least recently used first
+	size_type _capacity;
+
+  public:
+	/*
+	 * Constructs an empty cache holding at most `capacity` entries. The index is sized up front, so that a full cache
+	 * never rehashes.
+	 * Exceptions: `std::invalid_argument` if `capacity` is 0.
+	 * Complexity: Linear in `capacity`
+	 */
+	explicit xor_lru_cache(size_type capacity, const hasher &hash = hasher(), const key_equal &equal = key_equal(),
+						   const allocator_type &alloc = allocator_type())
+		: _entries(capacity + 1, hash, equal, alloc), _capacity(capacity) {
+		if (capacity == 0)
+			throw std::invalid_argument("xor_lru_cache: capacity must be positive");
+	}
+
+	const_iterator begin() const noexcept { return _entries.begin(); }
+	const_iterator end() const noexcept { return _entries.end(); }
+
+	[[nodiscard]] bool empty() const noexcept { return _entries.empty(); }
+	size_type size() const noexcept { return _entries.size(); }
+	size_type capacity() const noexcept { return _capacity; }
+
+	void clear() noexcept { _entries.clear(); }
+
+	/*
+	 * Looks `key` up and marks its entry as the most recently used.
+	 * Return value: Pointer to the cached value, or `nullptr` on a miss. The pointer stays valid until the entry is
+	 * evicted or erased.
+	 * Complexity: Constant on average
+	 */
+	mapped_type *get(const key_type &key) {
+		const auto it = _entries.find(key);
+
+		return it == _entries.end() ? nullptr : std::addressof(_entries.move_to_back(it)->second);
+	}
+
+	/*
+	 * Looks `key` up without changing its recency.
+	 * Complexity: Constant on average
+	 */
+	const mapped_type *peek(const key_type &key) const {
+		const auto it = _entries.find(key);
+
+		return it == _entries.end() ? nullptr : std::addressof(it->second);
+	}
+
+	bool contains(const key_type &key) const { return _entries.contains(key); }
+
+	/*
+	 * Inserts or replaces the value cached for `key` and marks it as the most recently used, evicting the least
+	 * recently used entry if the cache was full.
+	 * Return value: Reference to the cached value.
+	 * Complexity: Constant on average
+	 */
+	template <class M> mapped_type &put(const key_type &key, M &&obj) {
+		const auto [it, inserted] = _entries.insert_or_assign(key, std::forward<M>(obj));
+
+		if (!inserted)
+			_entries.move_to_back(it);
+		else if (_entries.size() > _capacity)
+			_entries.erase(_entries.begin());
+
+		return _entries.back().second;
+	}
+
+	/*
+	 * Marks the entry of `key`, if any, as the most recently used.
+	 * Return value: `true` if `key` is cached.
+	 * Complexity: Constant on average
+	 */
+	bool touch(const key_type &key) {
+		const auto it = _entries.find(key);
+
+		if (it == _entries.end())
+			return false;
+
+		_entries.move_to_back(it);
+
+		return true;
+	}
+
+	/*
+	 * Touches the keys of `[first, last)` in order, as a read burst would. Runs of a key that is already the most
+	 * recently used entry, which bursts are full of, cost a single key comparison instead of a lookup and a relink.
+	 * Return value: The number of keys that were cached.
+	 * Complexity: Linear in `std::distance(first, last)` on average
+	 */
+	template <class InputIt> size_type touch_many(InputIt first, InputIt last) {
+		const key_equal equal = _entries.key_eq();
+		size_type hits = 0;
+
+		for (; first != last; ++first) {
+			if (!_entries.empty() && equal(_entries.back().first, *first))
+				++hits;
+			else
+				hits += touch(*first);
+		}
+
+		return hits;
+	}
+
+	/*
+	 * Removes the entry of `key`, if any.
+	 * Return value: `true` if an entry was removed.
+	 * Complexity: Constant on average
+	 */
+	bool erase(const key_type &key) { return _entries.erase(key) != 0; }
+};
@@ -0,0 +1,154 @@
+/*
+ * https://man7.org/linux/man-pages/man2/mmap.2.html
+ * https://en.cppreference.com/w/cpp/string/basic_string_view
+ */
+module;
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+export module xor_mmap_loader;
+
+import <cerrno>;
+import <cstddef>;
+import <cstring>;
+
+import <filesystem>;
+import <memory>;
+import <stdexcept>;
+import <string_view>;
+import <system_error>;
+
+import xorlist;
+import xor_slab_allocator;
+
+/**
+ - [x] explicit mapped_file(const std::filesystem::path& path);
+ - [x] std::string_view view() const noexcept; std::size_t size() const noexcept;
+ - [x] mapped_lines load_lines(const std::filesystem::path& path, char delimiter);
+ - [x] mapped_lines load_records(const std::filesystem::path& path, std::size_t record_size);
+ */
+
+/*
+ * Read-only, private memory mapping of a whole file. Not copyable: share it through a `std::shared_ptr`.
+ */
+export class mapped_file {
+	const char *_data = nullptr;
+	std::size_t _size = 0;
+
+  public:
+	/*
+	 * Maps the file at `path` in memory, for a sequential scan.
+	 * Exceptions: `std::system_error` if the file cannot be opened, inspected or mapped.
+	 */
+	explicit mapped_file(const std::filesystem::path &path) {
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+		if (fd < 0)
+			throw std::system_error(errno, std::generic_category(), "mapped_file: cannot open " + path.string());
+
+		struct stat st;
+
+		if (::fstat(fd, &st) != 0) {
+			const int error = errno;
+			::close(fd);
+			throw std::system_error(error, std::generic_category(), "mapped_file: cannot stat " + path.string());
+		}
+
+		_size = static_cast<std::size_t>(st.st_size);
+
+		// an empty file cannot be mapped, and needs not be
+		if (_size != 0) {
+			void *data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if (data == MAP_FAILED) {
+				const int error = errno;
+				::close(fd);
+				throw std::system_error(error, std::generic_category(), "mapped_file: cannot map " + path.string());
+			}
+
+			::madvise(data, _size, MADV_SEQUENTIAL);
+			_data = static_cast<const char *>(data);
+		}
+
+		// the mapping outlives the descriptor
+		::close(fd);
+	}
+
+	mapped_file(const mapped_file &) = delete;
+	mapped_file &operator=(const mapped_file &) = delete;
+
+	~mapped_file() {
+		if (_data != nullptr)
+			::munmap(const_cast<char *>(_data), _size);
+	}
+
+	std::string_view view() const noexcept { return {_data, _size}; }
+
+	std::size_t size() const noexcept { return _size; }
+};
+
+/*
+ * List of views into a mapped file. Its nodes come from a slab allocator which holds the mapping, so the views remain
+ * valid as long as the list, or any copy of it, exists: a copy gets slabs of its own, anchored to the same mapping.
+ */
+export using mapped_lines = xorlist<std::string_view, xor_slab_allocator<std::string_view>>;
+
+// Slabs of a loader are larger than the default ones, since loaded files typically hold millions of records.
+constexpr std::size_t __loader_slab_size = std::size_t(1) << 20;
+
+mapped_lines __mapped_list(const std::shared_ptr<const mapped_file> &file) {
+	return mapped_lines(xor_slab_allocator<std::string_view>(__loader_slab_size, file));
+}
+
+/*
+ * Memory-maps the file at `path` and splits it into records separated by `delimiter`, without copying any byte of
+ * it. Delimiters are found with `std::memchr`, which the C library vectorizes. A trailing delimiter does not start an
+ * empty record.
+ * Parameters:
+ *   - path: file to load
+ *   - delimiter: record separator, excluded from the records
+ * Return value: The records, in file order.
+ * Complexity: Linear in the size of the file.
+ * Exceptions: `std::system_error` if the file cannot be mapped.
+ */
+export mapped_lines load_lines(const std::filesystem::path &path, char delimiter = '\n') {
+	const auto file = std::make_shared<const mapped_file>(path);
+	const std::string_view text = file->view();
+	mapped_lines lines = __mapped_list(file);
+
+	for (const char *first = text.data(), *const last = first + text.size(); first < last;) {
+		const void *found = std::memchr(first, delimiter, static_cast<std::size_t>(last - first));
+		const char *end = found != nullptr ? static_cast<const char *>(found) : last;
+
+		lines.emplace_back(first, static_cast<std::size_t>(end - first));
+		first = end + 1;
+	}
+
+	return lines;
+}
+
+/*
+ * Memory-maps the file at `path` and splits it into fixed-size binary records, without copying any byte of it.
+ * Parameters:
+ *   - path: file to load
+ *   - record_size: size of a record in bytes, non-zero; a shorter final record is kept as is
+ * Return value: The records, in file order.
+ * Complexity: Linear in the number of records.
+ * Exceptions: `std::invalid_argument` if `record_size` is 0, `std::system_error` if the file cannot be mapped.
+ */
+export mapped_lines load_records(const std::filesystem::path &path, std::size_t record_size) {
+	if (record_size == 0)
+		throw std::invalid_argument("load_records: record_size must be positive");
+
+	const auto file = std::make_shared<const mapped_file>(path);
+	const std::string_view data = file->view();
+	mapped_lines records = __mapped_list(file);
+
+	for (std::size_t pos = 0; pos < data.size(); pos += record_size)
+		records.emplace_back(data.substr(pos, record_size));
+
+	return records;
+}
@@ -0,0 +1,190 @@
+/*
+ * https://en.cppreference.com/w/cpp/named_req/Allocator
+ * https://en.wikipedia.org/wiki/Slab_allocation
+ */
+export module xor_slab_allocator;
+
+import <cstddef>;
+
+import <algorithm>;
+import <memory>;
+import <new>;
+import <utility>;
+import <vector>;
+
+/**
+ - [x] xor_slab_allocator();
+ - [x] explicit xor_slab_allocator(std::size_t slab_size, std::shared_ptr<const void> anchor = {});
+ - [x] template <class U> xor_slab_allocator(const xor_slab_allocator<U>& other) noexcept;
+ - [x] xor_slab_allocator select_on_container_copy_construction() const;
+ - [x] T* allocate(std::size_t n);
+ - [x] void deallocate(T* p, std::size_t n) noexcept;
+ - [x] std::size_t slab_size() const noexcept;
+ - [x] std::size_t slab_count() const noexcept;
+ - [x] std::size_t allocated_bytes() const noexcept;
+ */
+
+/*
+ * Memory shared by all the copies and rebinds of a `xor_slab_allocator`. Single objects are carved, per size class, out
+ * of large slabs and recycled through an intrusive free list; everything is returned to the system when the last
+ * allocator referring to the arena goes away. Not thread-safe.
+ */
+class __slab_arena {
+	struct __pool {
+		std::size_t _block;		   // size of a block, a multiple of its alignment
+		std::size_t _align;
+		void *_free = nullptr;	   // recycled blocks, chained through their first word
+		std::byte *_cursor = nullptr; // bump pointer into the newest slab
+		std::byte *_limit = nullptr;
+	};
+
+	struct __slab {
+		std::byte *_data;
+		std::size_t _size;
+		std::size_t _align;
+	};
+
+	std::size_t _slab_size;
+	std::vector<__pool> _pools; // one per size class; containers only use a handful
+	std::vector<__slab> _slabs;
+	std::shared_ptr<const void> _anchor; // kept alive as long as the arena, e.g. memory the elements refer to
+
+  public:
+	explicit __slab_arena(std::size_t slab_size, std::shared_ptr<const void> anchor = {})
+		: _slab_size(slab_size), _anchor(std::move(anchor)) {}
+
+	__slab_arena(const __slab_arena &) = delete;
+	__slab_arena &operator=(const __slab_arena &) = delete;
+
+	~__slab_arena() {
+		for (const __slab &slab : _slabs)
+			::operator delete(slab._data, slab._size, std::align_val_t(slab._align));
+	}
+
+	std::size_t slab_size() const noexcept { return _slab_size; }
+
+	const std::shared_ptr<const void> &anchor() const noexcept { return _anchor; }
+
+	std::size_t slab_count() const noexcept { return _slabs.size(); }
+
+	std::size_t allocated_bytes() const noexcept {
+		std::size_t bytes = 0;
+
+		for (const __slab &slab : _slabs)
+			bytes += slab._size;
+
+		return bytes;
+	}
+
+	// Calls `f(data, size)` on every slab, oldest first.
+	template <class F> void for_each_slab(F &&f) const {
+		for (const __slab &slab : _slabs)
+			f(static_cast<const std::byte *>(slab._data), slab._size);
+	}
+
+	void *allocate(std::size_t size, std::size_t align) {
+		__pool &pool = __pool_for(size, align);
+
+		if (pool._free != nullptr)
+			return std::exchange(pool._free, *static_cast<void **>(pool._free));
+
+		if (pool._cursor == pool._limit) {
+			const std::size_t bytes = std::max(_slab_size, pool._block) / pool._block * pool._block;
+			std::byte *data = static_cast<std::byte *>(::operator new(bytes, std::align_val_t(pool._align)));
+
+			_slabs.push_back({data, bytes, pool._align});
+			pool._cursor = data;
+			pool._limit = data + bytes;
+		}
+
+		return std::exchange(pool._cursor, pool._cursor + pool._block);
+	}
+
+	void deallocate(void *p, std::size_t size, std::size_t align) noexcept {
+		__pool &pool = __pool_for(size, align);
+
+		*static_cast<void **>(p) = pool._free;
+		pool._free = p;
+	}
+
+  private:
+	__pool &__pool_for(std::size_t size, std::size_t align) {
+		align = std::max(align, alignof(void *));
+		const std::size_t block = (std::max(size, sizeof(void *)) + align - 1) / align * align;
+
+		for (__pool &pool : _pools)
+			if (pool._block == block && pool._align == align)
+				return pool;
+
+		return _pools.emplace_back(__pool{block, align});
+	}
+};
+
+/*
+ * Allocator drawing single objects, typically container nodes, from slabs, so that nodes allocated together are
+ * contiguous in memory and cost no per-allocation header. Array allocations go to the global `operator new`.
+ * Copies and rebinds share the same arena and compare equal; default-constructed allocators each own a new arena.
+ * An `anchor` can be attached to the arena, to tie the lifetime of something the elements refer to (a memory mapping,
+ * a string pool) to the containers using the allocator.
+ * Since the arena is not thread-safe, a copied container gets a new arena, with the same slab size and anchor, and a
+ * copy-assigned one keeps its own: distinct containers can then be used on different threads, as usual.
+ */
+export template <class T> class xor_slab_allocator {
+	template <class U> friend class xor_slab_allocator;
+
+	std::shared_ptr<__slab_arena> _arena;
+
+  public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+	using is_always_equal = std::false_type;
+
+	static constexpr std::size_t default_slab_size = 64 * 1024;
+
+	xor_slab_allocator() : xor_slab_allocator(default_slab_size) {}
+
+	/*
+	 * Constructs an allocator with a new arena.
+	 * Parameters:
+	 *   - slab_size: number of bytes requested from the system at once
+	 *   - anchor: object kept alive until the arena is destroyed
+	 */
+	explicit xor_slab_allocator(std::size_t slab_size, std::shared_ptr<const void> anchor = {})
+		: _arena(std::make_shared<__slab_arena>(slab_size, std::move(anchor))) {}
+
+	template <class U> xor_slab_allocator(const xor_slab_allocator<U> &other) noexcept : _arena(other._arena) {}
+
+	// Allocator of a copied container: a new arena, which keeps the same anchor alive.
+	xor_slab_allocator select_on_container_copy_construction() const {
+		return xor_slab_allocator(_arena->slab_size(), _arena->anchor());
+	}
+
+	[[nodiscard]] T *allocate(std::size_t n) {
+		if (n == 1)
+			return static_cast<T *>(_arena->allocate(sizeof(T), alignof(T)));
+
+		return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+	}
+
+	void deallocate(T *p, std::size_t n) noexcept {
+		if (n == 1)
+			_arena->deallocate(p, sizeof(T), alignof(T));
+		else
+			::operator delete(p, n * sizeof(T), std::align_val_t(alignof(T)));
+	}
+
+	std::size_t slab_size() const noexcept { return _arena->slab_size(); }
+
+	std::size_t slab_count() const noexcept { return _arena->slab_count(); }
+
+	// Bytes obtained from the system, whether in use or on a free list.
+	std::size_t allocated_bytes() const noexcept { return _arena->allocated_bytes(); }
+
+	template <class F> void for_each_slab(F &&f) const { _arena->for_each_slab(std::forward<F>(f)); }
+
+	template <class U> bool operator==(const xor_slab_allocator<U> &other) const noexcept {
+		return _arena == other._arena;
+	}
+};
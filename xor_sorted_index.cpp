@@ -0,0 +1,426 @@
+/*
+ * https://en.wikipedia.org/wiki/Skip_list
+ * https://en.wikipedia.org/wiki/B-tree
+ */
+export module xor_sorted_index;
+
+import <cstddef>;
+
+import <algorithm>;
+import <functional>;
+import <initializer_list>;
+import <iterator>;
+import <memory>;
+import <utility>;
+import <vector>;
+
+import xorlist;
+
+/**
+ - [x] xor_sorted_index();
+ - [x] explicit xor_sorted_index(const compare_type& comp, size_type stride, const allocator_type& alloc);
+ - [x] explicit xor_sorted_index(list_type&& sorted, const compare_type& comp, size_type stride);
+ - [x] xor_sorted_index(initializer_list<value_type>);
+ - [x] xor_sorted_index(const xor_sorted_index&); xor_sorted_index(xor_sorted_index&&) noexcept;
+ - [x] const_iterator begin() const noexcept; const_iterator end() const noexcept;
+ - [x] bool empty() const noexcept; size_type size() const noexcept;
+ - [x] void clear() noexcept;
+ - [x] template <class... Args> const_iterator emplace(Args&&... args);
+ - [x] const_iterator insert(const value_type& value);
+ - [x] const_iterator erase(const_iterator pos);
+ - [x] size_type erase(const value_type& key);
+ - [x] const_iterator lower_bound(const value_type& key) const;
+ - [x] const_iterator upper_bound(const value_type& key) const;
+ - [x] pair<const_iterator, const_iterator> equal_range(const value_type& key) const;
+ - [x] const_iterator find(const value_type& key) const;
+ - [x] size_type count(const value_type& key) const; bool contains(const value_type& key) const;
+ - [x] const list_type& list() const noexcept; list_type release() noexcept;
+ - [x] size_type stride() const noexcept; size_type index_size() const noexcept;
+ */
+
+/*
+ * Sorted `xorlist` with an index of sampled positions, for O(log n) sorted search. The list is cut into runs of
+ * `stride / 2` to `2 * stride` consecutive elements (a single run may be shorter), and the index holds the position of
+ * the first element of every run: a search binary-searches the runs, then walks at most one run. This is a one-level B-tree (or a skip list with a
+ * single express lane) whose leaves are the list itself, so the elements keep the single link word of `xorlist`, and
+ * the whole list can be taken out with `release()` to be spliced or merged in O(1) per element.
+ * Runs are split in two when they outgrow `2 * stride` elements; a run which shrinks below `stride / 2` takes an
+ * element from a neighbour, or is merged with it if the neighbour is at the minimum too, as in a B-tree. The index thus
+ * holds between `size() / (2 * stride)` and `2 * size() / stride` positions. The index is a vector, so a split or a merge shifts the positions
+ * after it, in O(n / stride); since a run is split at most once every `stride` insertions into it, an insertion costs
+ * O(log n + stride) plus O(n / stride^2) amortized. The shift is a move of contiguous positions, but for very large
+ * containers with a small stride, it dominates: choose `stride` about `sqrt(n / log n)` there.
+ * Notes: A sampled position embeds the predecessor of its element, so every insertion and erasure refreshes the run
+ * following the modified node. Elements are only reachable through const iterators, since modifying them in place
+ * could break the ordering.
+ */
+export template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T>> class xor_sorted_index {
+  public:
+	// Member types
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using compare_type = Compare;
+	using allocator_type = Allocator;
+	using list_type = xorlist<T, Allocator>;
+	using const_reference = const value_type &;
+	using const_iterator = typename list_type::const_iterator;
+	using iterator = const_iterator;
+
+	static constexpr size_type default_stride = 16;
+
+  private:
+	struct __run {
+		const_iterator _first;
+		size_type _size;
+	};
+
+	using __run_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<__run>;
+
+	list_type _list;
+	std::vector<__run, __run_allocator> _runs; // tile the list in order, `_runs.front()._first == _list.begin()`
+	size_type _stride = default_stride;
+	[[no_unique_address]] compare_type _comp;
+
+	/* Member functions */
+
+  public:
+	xor_sorted_index() = default;
+
+	/*
+	 * Constructs an empty container.
+	 * Parameters:
+	 *   - comp: comparison function object to use for all comparisons of elements
+	 *   - stride: minimal number of elements between two sampled positions, larger values trade search speed for a
+	 * smaller index
+	 *   - alloc: allocator to use for all memory allocations of this container
+	 * Complexity: Constant
+	 */
+	explicit xor_sorted_index(const compare_type &comp, size_type stride = default_stride,
+							  const allocator_type &alloc = allocator_type())
+		: _list(alloc), _runs(__run_allocator(alloc)), _stride(std::max<size_type>(stride, 1)), _comp(comp) {}
+
+	/*
+	 * Takes ownership of the nodes of `sorted`, which must be sorted with respect to `comp`, and indexes them.
+	 * Complexity: Linear in the size of `sorted`
+	 */
+	explicit xor_sorted_index(list_type &&sorted, const compare_type &comp = compare_type(),
+							  size_type stride = default_stride)
+		: _list(std::move(sorted)), _runs(__run_allocator(_list.get_allocator())),
+		  _stride(std::max<size_type>(stride, 1)), _comp(comp) {
+		__reindex();
+	}
+
+	xor_sorted_index(std::initializer_list<value_type> init) {
+		for (const value_type &value : init)
+			insert(value);
+	}
+
+	/*
+	 * Copy constructor. The sampled positions refer to the nodes of `other`, so the copy is indexed anew.
+	 * Complexity: Linear in size of `other`
+	 */
+	xor_sorted_index(const xor_sorted_index &other)
+		: _list(other._list), _runs(other._runs.get_allocator()), _stride(other._stride), _comp(other._comp) {
+		__reindex();
+	}
+
+	/*
+	 * Move constructor. The nodes are taken over; only the first run, whose position goes through the end sentinel of
+	 * `other`, has to be refreshed.
+	 * Complexity: Constant
+	 */
+	xor_sorted_index(xor_sorted_index &&other) noexcept
+		: _list(std::move(other._list)), _runs(std::move(other._runs)), _stride(other._stride),
+		  _comp(std::move(other._comp)) {
+		other._runs.clear();
+
+		if (!_runs.empty())
+			_runs.front()._first = _list.begin();
+	}
+
+	xor_sorted_index &operator=(const xor_sorted_index &other) {
+		if (this != std::addressof(other)) {
+			xor_sorted_index copy(other);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	xor_sorted_index &operator=(xor_sorted_index &&other) noexcept {
+		if (this != std::addressof(other)) {
+			_list.clear();
+			_list.splice(_list.end(), other._list);
+			_runs = std::move(other._runs);
+			_stride = other._stride;
+			_comp = std::move(other._comp);
+			other._runs.clear();
+
+			if (!_runs.empty())
+				_runs.front()._first = _list.begin();
+		}
+
+		return *this;
+	}
+
+	/* Iterators */
+
+	const_iterator begin() const noexcept { return _list.begin(); }
+	const_iterator cbegin() const noexcept { return _list.cbegin(); }
+	const_iterator end() const noexcept { return _list.end(); }
+	const_iterator cend() const noexcept { return _list.cend(); }
+
+	/* Capacity */
+
+	[[nodiscard]] bool empty() const noexcept { return _list.empty(); }
+
+	size_type size() const noexcept { return _list.size(); }
+
+	size_type stride() const noexcept { return _stride; }
+
+	// Number of runs, i.e. of positions in the index.
+	size_type index_size() const noexcept { return _runs.size(); }
+
+	/* Modifiers */
+
+	void clear() noexcept {
+		_list.clear();
+		_runs.clear();
+	}
+
+	/*
+	 * Inserts an element constructed in place from `args...` after the elements equivalent to it, which keeps equal
+	 * elements in insertion order.
+	 * Return value: Iterator to the inserted element.
+	 * Complexity: Logarithmic in the size of the container, plus `stride`, plus linear in the number of runs when a run
+	 * is split, which is O(size() / stride^2) amortized
+	 */
+	template <class... Args> const_iterator emplace(Args &&...args) {
+		return insert(value_type(std::forward<Args>(args)...));
+	}
+
+	const_iterator insert(const value_type &value) {
+		const auto [k, pos] = __upper_bound(value);
+
+		return __insert_at(k, pos, value);
+	}
+
+	const_iterator insert(value_type &&value) {
+		const auto [k, pos] = __upper_bound(value);
+
+		return __insert_at(k, pos, std::move(value));
+	}
+
+	/*
+	 * Removes the element at `pos`.
+	 * Return value: Iterator following the removed element.
+	 * Complexity: Logarithmic in the size of the container, plus `stride`, plus linear in the number of runs when two
+	 * runs are merged, which is O(size() / stride^2) amortized
+	 */
+	const_iterator erase(const_iterator pos) {
+		size_type k = __run_of(pos);
+
+		return __erase_at(k, pos);
+	}
+
+	/*
+	 * Removes all the elements equivalent to `key`.
+	 * Return value: Number of elements removed.
+	 * Complexity: Logarithmic in the size of the container, plus linear in the number of elements removed
+	 */
+	size_type erase(const value_type &key) {
+		auto [k, pos] = __lower_bound(key);
+		size_type count = 0;
+
+		for (; pos != end() && !_comp(key, *pos); ++count)
+			pos = __erase_at(k, pos);
+
+		return count;
+	}
+
+	/*
+	 * Hands the list over to the caller, e.g. to splice or merge it cheaply, leaving the container empty.
+	 * Complexity: Constant
+	 */
+	list_type release() noexcept {
+		_runs.clear();
+		return std::move(_list);
+	}
+
+	/* Lookup */
+
+	/*
+	 * Returns an iterator to the first element not less than `key`.
+	 * Complexity: Logarithmic in the size of the container
+	 */
+	const_iterator lower_bound(const value_type &key) const { return __lower_bound(key).second; }
+
+	/*
+	 * Returns an iterator to the first element greater than `key`.
+	 * Complexity: Logarithmic in the size of the container
+	 */
+	const_iterator upper_bound(const value_type &key) const { return __upper_bound(key).second; }
+
+	std::pair<const_iterator, const_iterator> equal_range(const value_type &key) const {
+		return {lower_bound(key), upper_bound(key)};
+	}
+
+	const_iterator find(const value_type &key) const {
+		const const_iterator it = lower_bound(key);
+
+		return it == end() || _comp(key, *it) ? end() : it;
+	}
+
+	size_type count(const value_type &key) const {
+		const auto [first, last] = equal_range(key);
+
+		return static_cast<size_type>(std::distance(first, last));
+	}
+
+	bool contains(const value_type &key) const { return find(key) != end(); }
+
+	/* Observers */
+
+	const list_type &list() const noexcept { return _list; }
+
+	compare_type value_comp() const { return _comp; }
+
+  private:
+	/*
+	 * Finds the first element for which `pred` is false, the list being partitioned by `pred`.
+	 * Return value: The index of the run to insert at, and the position of that element.
+	 */
+	template <class Pred> std::pair<size_type, const_iterator> __partition_point(Pred pred) const {
+		if (_runs.empty())
+			return {0, end()};
+
+		const auto run = std::partition_point(_runs.begin() + 1, _runs.end(),
+											  [&](const __run &r) { return pred(*r._first); });
+		const size_type k = static_cast<size_type>(run - _runs.begin()) - 1;
+		const_iterator it = _runs[k]._first;
+
+		for (size_type n = _runs[k]._size; n != 0 && pred(*it); --n)
+			++it;
+
+		return {k, it};
+	}
+
+	std::pair<size_type, const_iterator> __lower_bound(const value_type &key) const {
+		return __partition_point([&](const value_type &e) { return _comp(e, key); });
+	}
+
+	std::pair<size_type, const_iterator> __upper_bound(const value_type &key) const {
+		return __partition_point([&](const value_type &e) { return !_comp(key, e); });
+	}
+
+	// Index of the run holding `pos`; equivalent elements may span several runs.
+	size_type __run_of(const_iterator pos) const {
+		size_type k = __lower_bound(*pos).first;
+
+		for (const_iterator it = _runs[k]._first;; ++k)
+			for (size_type n = _runs[k]._size; n != 0; --n, ++it)
+				if (it == pos)
+					return k;
+	}
+
+	template <class V> const_iterator __insert_at(size_type k, const_iterator pos, V &&value) {
+		const const_iterator it = _list.insert(pos, std::forward<V>(value));
+
+		if (_runs.empty()) {
+			_runs.push_back({it, 1});
+			return it;
+		}
+
+		if (pos == _runs[k]._first)
+			_runs[k]._first = it; // new first element of the run
+		else if (k + 1 < _runs.size() && pos == _runs[k + 1]._first)
+			_runs[k + 1]._first = std::next(it); // same element, new predecessor
+
+		if (++_runs[k]._size > 2 * _stride) {
+			const const_iterator middle = std::next(_runs[k]._first, static_cast<difference_type>(_stride));
+
+			_runs.insert(_runs.begin() + static_cast<difference_type>(k) + 1, {middle, _runs[k]._size - _stride});
+			_runs[k]._size = _stride;
+		}
+
+		return it;
+	}
+
+	// Erases `pos` from run `k`, and leaves `k` at the run of the next element to the extent it is known.
+	const_iterator __erase_at(size_type &k, const_iterator pos) {
+		if (k + 1 < _runs.size() && pos == _runs[k + 1]._first)
+			++k; // searches stop past the end of a run rather than at the start of the next one
+
+		const bool first = pos == _runs[k]._first;
+		const const_iterator next = _list.erase(pos);
+
+		if (k + 1 < _runs.size() && next == _runs[k + 1]._first)
+			_runs[k + 1]._first = next; // same element, new predecessor
+
+		if (--_runs[k]._size == 0)
+			_runs.erase(_runs.begin() + static_cast<difference_type>(k));
+		else {
+			if (first)
+				_runs[k]._first = next;
+
+			__rebalance(k);
+		}
+
+		return next;
+	}
+
+	size_type __min_run() const noexcept { return std::max<size_type>(_stride / 2, 1); }
+
+	// Brings run `k` back to `__min_run()` elements after an erasure, keeping `k` at the run of the same elements.
+	void __rebalance(size_type &k) {
+		if (_runs[k]._size >= __min_run() || _runs.size() == 1)
+			return;
+
+		if (k + 1 < _runs.size()) {
+			__run &next = _runs[k + 1];
+
+			if (next._size > __min_run()) {
+				++next._first;
+				--next._size;
+				++_runs[k]._size;
+			} else {
+				_runs[k]._size += next._size;
+				_runs.erase(_runs.begin() + static_cast<difference_type>(k) + 1);
+			}
+		} else {
+			__run &prev = _runs[k - 1];
+
+			if (prev._size > __min_run()) {
+				--_runs[k]._first;
+				++_runs[k]._size;
+				--prev._size;
+			} else {
+				prev._size += _runs[k]._size;
+				_runs.erase(_runs.begin() + static_cast<difference_type>(k--));
+			}
+		}
+	}
+
+	void __reindex() {
+		_runs.clear();
+		_runs.reserve(_list.size() / _stride + 1);
+
+		size_type n = 0;
+
+		for (const_iterator it = _list.begin(); it != _list.end(); ++it, ++n)
+			if (n % _stride == 0)
+				_runs.push_back({it, 0});
+
+		for (__run &run : _runs) {
+			run._size = std::min(_stride, n);
+			n -= run._size;
+		}
+
+		// a short last run joins its predecessor
+		if (_runs.size() > 1 && _runs.back()._size < __min_run()) {
+			_runs[_runs.size() - 2]._size += _runs.back()._size;
+			_runs.pop_back();
+		}
+	}
+};
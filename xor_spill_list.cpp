@@ -0,0 +1,399 @@
+/*
+ * https://en.wikipedia.org/wiki/External_memory_algorithm
+ * https://man7.org/linux/man-pages/man2/pwrite.2.html
+ */
+module;
+
+#include <stdlib.h>
+#include <unistd.h>
+
+export module xor_spill_list;
+
+import <cerrno>;
+import <cstddef>;
+import <cstdint>;
+
+import <filesystem>;
+import <iterator>;
+import <memory>;
+import <stdexcept>;
+import <string>;
+import <system_error>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+
+import xorlist;
+
+/**
+ - [x] explicit xor_spill_list(std::size_t budget, size_type segment_capacity);
+ - [x] iterator begin(); iterator end();
+ - [x] reference front(); reference back();
+ - [x] size_type size() const noexcept; bool empty() const noexcept;
+ - [x] size_type resident_size() const noexcept; size_type spilled_segments() const noexcept;
+ - [x] void push_back(const value_type& value);
+ - [x] void pop_front();
+ - [x] void clear() noexcept;
+ */
+
+// Anonymous temporary file, unlinked as soon as it is created: it vanishes with its descriptor, even on a crash.
+class __spill_file {
+	int _fd;
+
+  public:
+	__spill_file() {
+		std::string path = (std::filesystem::temp_directory_path() / "xor_spill_XXXXXX").string();
+		_fd = ::mkstemp(path.data());
+
+		if (_fd < 0)
+			throw std::system_error(errno, std::generic_category(), "xor_spill_list: cannot create " + path);
+
+		::unlink(path.c_str());
+	}
+
+	__spill_file(const __spill_file &) = delete;
+	__spill_file &operator=(const __spill_file &) = delete;
+
+	~__spill_file() { ::close(_fd); }
+
+	void write(const void *data, std::size_t size, std::size_t offset) {
+		for (const char *p = static_cast<const char *>(data); size != 0;) {
+			const ::ssize_t written = ::pwrite(_fd, p, size, static_cast<::off_t>(offset));
+
+			if (written < 0 && errno != EINTR)
+				throw std::system_error(errno, std::generic_category(), "xor_spill_list: cannot write segment");
+
+			if (written > 0) {
+				p += written;
+				size -= static_cast<std::size_t>(written);
+				offset += static_cast<std::size_t>(written);
+			}
+		}
+	}
+
+	void read(void *data, std::size_t size, std::size_t offset) const {
+		for (char *p = static_cast<char *>(data); size != 0;) {
+			const ::ssize_t got = ::pread(_fd, p, size, static_cast<::off_t>(offset));
+
+			if (got == 0)
+				throw std::runtime_error("xor_spill_list: truncated segment");
+
+			if (got < 0 && errno != EINTR)
+				throw std::system_error(errno, std::generic_category(), "xor_spill_list: cannot read segment");
+
+			if (got > 0) {
+				p += got;
+				size -= static_cast<std::size_t>(got);
+				offset += static_cast<std::size_t>(got);
+			}
+		}
+	}
+};
+
+/*
+ * Sequence stored as a `xorlist` of segments, each holding up to `segment_capacity` consecutive elements in a
+ * `xorlist` of its own, under a memory budget. When the resident elements exceed the budget, the least recently used
+ * segments are written to an anonymous temporary file and their nodes freed, leaving a placeholder segment node that
+ * only records where they went. Spilled segments are read back transparently when iteration, `front()` or `pop_front()`
+ * reaches them; their file slot is then reused by the next spill.
+ * The back segment, which receives `push_back`, is never spilled, and neither is the segment being paged in, so the
+ * budget can be exceeded by up to two segments.
+ * Notes: `T` must be trivially copyable, since segments are written and read back as raw bytes.
+ */
+export template <class T> class xor_spill_list {
+	static_assert(std::is_trivially_copyable_v<T>, "xor_spill_list: elements are spilled as raw bytes");
+
+  public:
+	// Member types
+	using value_type = T;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+
+	static constexpr size_type default_segment_capacity = 4096;
+
+  private:
+	struct __segment {
+		xorlist<T> _elements; // empty while spilled
+		size_type _size = 0;
+		size_type _slot = 0;           // slot in the spill file, meaningful while spilled
+		std::uint64_t _last_use = 0;   // recency for the choice of the segments to spill
+		std::uint64_t _generation = 0; // changes when the segment is paged in, so that iterators reseek
+		bool _spilled = false;
+	};
+
+	using __segment_list = xorlist<__segment>;
+	using __segment_iterator = typename __segment_list::iterator;
+
+	// estimated footprint of a resident element: its value and its link
+	static constexpr size_type __element_bytes = sizeof(T) + sizeof(void *);
+
+	__segment_list _segments;
+	size_type _size = 0;
+	size_type _resident = 0;
+	size_type _max_resident;
+	size_type _segment_capacity;
+	size_type _spilled_segments = 0;
+	std::uint64_t _clock = 0;
+	std::vector<__segment *> _hot;       // resident segments, in no particular order
+	std::unique_ptr<__spill_file> _file; // created by the first spill
+	size_type _slots = 0;                // slots in the spill file
+	std::vector<size_type> _free_slots;
+
+  public:
+	/*
+	 * Iterator over the elements, which pages spilled segments in as it reaches them. Paging a segment in may spill
+	 * others; iterators into them remain valid and read them back when dereferenced.
+	 */
+	class iterator {
+		xor_spill_list *_list = nullptr;
+		__segment_iterator _segment;
+		size_type _index = 0;
+		mutable typename xorlist<T>::iterator _it;
+		mutable std::uint64_t _generation = 0; // generation of the segment when `_it` was computed, 0 if none
+
+		friend xor_spill_list;
+
+		iterator(xor_spill_list *list, __segment_iterator segment) : _list(list), _segment(segment) {}
+
+		void __sync() const {
+			if (_segment->_spilled || _generation != _segment->_generation) {
+				_list->__page_in(*_segment);
+				_it = std::next(_segment->_elements.begin(), static_cast<difference_type>(_index));
+				_generation = _segment->_generation;
+			}
+		}
+
+	  public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T *;
+		using reference = T &;
+
+		iterator() = default;
+
+		reference operator*() const {
+			__sync();
+			return *_it;
+		}
+
+		pointer operator->() const { return std::addressof(**this); }
+
+		iterator &operator++() {
+			__sync();
+			++_it;
+
+			if (++_index == _segment->_size) {
+				++_segment;
+				_index = 0;
+				_generation = 0;
+			}
+
+			return *this;
+		}
+
+		iterator operator++(int) {
+			iterator __tmp = *this;
+			++*this;
+			return __tmp;
+		}
+
+		friend bool operator==(const iterator &x, const iterator &y) noexcept {
+			return x._segment == y._segment && x._index == y._index;
+		}
+	};
+
+	/*
+	 * Constructs an empty list.
+	 * Parameters:
+	 *   - budget: memory, in bytes, that resident elements may use, estimated as `sizeof(T) + sizeof(void*)` each
+	 *   - segment_capacity: number of elements per segment, the unit of spilling
+	 * Exceptions: `std::invalid_argument` if `segment_capacity` is 0.
+	 */
+	explicit xor_spill_list(std::size_t budget, size_type segment_capacity = default_segment_capacity)
+		: _max_resident(budget / __element_bytes), _segment_capacity(segment_capacity) {
+		if (segment_capacity == 0)
+			throw std::invalid_argument("xor_spill_list: segment_capacity must be positive");
+	}
+
+	xor_spill_list(const xor_spill_list &) = delete;
+	xor_spill_list &operator=(const xor_spill_list &) = delete;
+	// Takes over the segments and the spill file of `other`, which is left empty.
+	xor_spill_list(xor_spill_list &&other) noexcept
+		: _segments(std::move(other._segments)), _size(std::exchange(other._size, 0)),
+		  _resident(std::exchange(other._resident, 0)), _max_resident(other._max_resident),
+		  _segment_capacity(other._segment_capacity), _spilled_segments(std::exchange(other._spilled_segments, 0)),
+		  _clock(std::exchange(other._clock, 0)), _hot(std::move(other._hot)), _file(std::move(other._file)),
+		  _slots(std::exchange(other._slots, 0)), _free_slots(std::move(other._free_slots)) {
+		other._segments.clear();
+		other._hot.clear();
+		other._free_slots.clear();
+	}
+
+	xor_spill_list &operator=(xor_spill_list &&other) noexcept {
+		if (this != std::addressof(other)) {
+			_segments = std::move(other._segments);
+			_size = std::exchange(other._size, 0);
+			_resident = std::exchange(other._resident, 0);
+			_max_resident = other._max_resident;
+			_segment_capacity = other._segment_capacity;
+			_spilled_segments = std::exchange(other._spilled_segments, 0);
+			_clock = std::exchange(other._clock, 0);
+			_hot = std::move(other._hot);
+			_file = std::move(other._file);
+			_slots = std::exchange(other._slots, 0);
+			_free_slots = std::move(other._free_slots);
+			other._segments.clear();
+			other._hot.clear();
+			other._free_slots.clear();
+		}
+
+		return *this;
+	}
+
+	iterator begin() { return iterator(this, _segments.begin()); }
+	iterator end() { return iterator(this, _segments.end()); }
+
+	[[nodiscard]] bool empty() const noexcept { return _size == 0; }
+	size_type size() const noexcept { return _size; }
+
+	// Number of elements in memory.
+	size_type resident_size() const noexcept { return _resident; }
+
+	// Number of segments on disk.
+	size_type spilled_segments() const noexcept { return _spilled_segments; }
+
+	/*
+	 * Returns a reference to the first element, paging its segment in if needed. Calling `front` on an empty list is
+	 * undefined.
+	 */
+	reference front() {
+		__page_in(_segments.front());
+		return _segments.front()._elements.front();
+	}
+
+	// The back segment is always resident.
+	reference back() { return _segments.back()._elements.back(); }
+
+	/*
+	 * Appends `value`. When the back segment is full, the coldest segments are spilled while the budget is exceeded,
+	 * then a new segment is started.
+	 * Complexity: Constant, plus the size of the spilled segments.
+	 * Exceptions: `std::system_error` if a segment cannot be spilled, in which case this function has no effect.
+	 */
+	void push_back(const value_type &value) {
+		if (_segments.empty() || _segments.back()._size == _segment_capacity) {
+			// the previous back segment becomes spillable
+			__enforce_budget(nullptr);
+
+			__segment &__s = _segments.emplace_back();
+			__s._generation = ++_clock;
+			_hot.push_back(std::addressof(__s));
+		}
+
+		__segment &__back = _segments.back();
+		__back._elements.push_back(value);
+		++__back._size;
+		++_size;
+		++_resident;
+		__back._last_use = ++_clock;
+	}
+
+	/*
+	 * Removes the first element, paging its segment in if needed. Calling `pop_front` on an empty list is undefined.
+	 * Complexity: Constant, plus the size of the segment if it was spilled.
+	 */
+	void pop_front() {
+		__segment &__s = _segments.front();
+		__page_in(__s);
+
+		__s._elements.pop_front();
+		--_size;
+		--_resident;
+
+		if (--__s._size == 0) {
+			std::erase(_hot, std::addressof(__s));
+			_segments.pop_front();
+		}
+	}
+
+	// Erases all the elements; the spill file is kept for later spills.
+	void clear() noexcept {
+		_segments.clear();
+		_hot.clear();
+		_size = _resident = _spilled_segments = 0;
+		_free_slots.clear();
+		_slots = 0;
+	}
+
+  private:
+	size_type __slot_bytes() const noexcept { return _segment_capacity * sizeof(T); }
+
+	// Writes `*_hot[__i]` to a free slot of the spill file and frees its nodes. Has no effect if an exception is
+	// thrown.
+	void __spill(size_type __i) {
+		__segment &__s = *_hot[__i];
+
+		if (!_file)
+			_file = std::make_unique<__spill_file>();
+
+		const std::vector<T> __buffer(__s._elements.begin(), __s._elements.end());
+		const size_type __slot = _free_slots.empty() ? _slots : _free_slots.back();
+
+		_file->write(__buffer.data(), __buffer.size() * sizeof(T), __slot * __slot_bytes());
+
+		if (_free_slots.empty())
+			++_slots;
+		else
+			_free_slots.pop_back();
+
+		__s._elements.clear();
+		__s._slot = __slot;
+		__s._spilled = true;
+		_resident -= __s._size;
+		++_spilled_segments;
+		_hot[__i] = _hot.back();
+		_hot.pop_back();
+	}
+
+	// Reads `__s` back if it was spilled, marks it as used, and restores the budget without spilling it.
+	void __page_in(__segment &__s) {
+		if (__s._spilled) {
+			std::vector<T> __buffer(__s._size);
+			_file->read(__buffer.data(), __buffer.size() * sizeof(T), __s._slot * __slot_bytes());
+			_hot.reserve(_hot.size() + 1);
+			__s._elements.append_range(__buffer);
+			_hot.push_back(std::addressof(__s));
+
+			_free_slots.push_back(__s._slot);
+			__s._spilled = false;
+			__s._generation = ++_clock;
+			_resident += __s._size;
+			--_spilled_segments;
+		}
+
+		__s._last_use = ++_clock;
+		__enforce_budget(std::addressof(__s));
+	}
+
+	// Spills the least recently used segments, except the back one and `__pinned`, until the budget is met. The scan
+	// only visits resident segments, whose number the budget bounds.
+	void __enforce_budget(const __segment *__pinned) {
+		while (_resident > _max_resident) {
+			const __segment *const __back = std::addressof(_segments.back());
+			size_type __coldest = _hot.size();
+
+			for (size_type __i = 0; __i < _hot.size(); ++__i)
+				if (_hot[__i] != __back && _hot[__i] != __pinned &&
+					(__coldest == _hot.size() || _hot[__i]->_last_use < _hot[__coldest]->_last_use))
+					__coldest = __i;
+
+			if (__coldest == _hot.size())
+				return;
+
+			__spill(__coldest);
+		}
+	}
+};
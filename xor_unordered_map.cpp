@@ -0,0 +1,550 @@
+/*
+ * https://en.cppreference.com/w/cpp/container/unordered_map
+ * https://en.wikipedia.org/wiki/Hash_table#Separate_chaining
+ */
+export module xor_unordered_map;
+
+import <cstddef>;
+import <cstdint>;
+
+import <algorithm>;
+import <bit>;
+import <functional>;
+import <initializer_list>;
+import <iterator>;
+import <memory>;
+import <stdexcept>;
+import <tuple>;
+import <utility>;
+import <vector>;
+
+import xor_slab_allocator;
+
+/**
+ - [x] xor_unordered_map();
+ - [x] explicit xor_unordered_map(size_type bucket_count, const hasher& hash, const key_equal& equal,
+ const allocator_type& alloc);
+ - [x] xor_unordered_map(const xor_unordered_map&);
+ - [x] xor_unordered_map(xor_unordered_map&&) noexcept;
+ - [x] xor_unordered_map(initializer_list<value_type>);
+ - [x] ~xor_unordered_map();
+ - [x] iterator begin() noexcept; iterator end() noexcept;
+ - [x] bool empty() const noexcept; size_type size() const noexcept;
+ - [x] void clear() noexcept;
+ - [x] template <class... Args> pair<iterator, bool> try_emplace(const key_type& k, Args&&... args);
+ - [x] pair<iterator, bool> insert(const value_type& value);
+ - [x] iterator erase(const_iterator pos);
+ - [x] size_type erase(const key_type& key);
+ - [x] void swap(xor_unordered_map& other) noexcept;
+ - [x] mapped_type& at(const key_type& key);
+ - [x] mapped_type& operator[](const key_type& key);
+ - [x] iterator find(const key_type& key);
+ - [x] bool contains(const key_type& key) const;
+ - [x] size_type bucket_count() const noexcept; size_type bucket_size(size_type n) const;
+ - [x] float load_factor() const noexcept; float max_load_factor() const noexcept; void max_load_factor(float ml);
+ - [x] void rehash(size_type count); void reserve(size_type count);
+ */
+
+/*
+ * Separate-chaining hash map whose bucket chains are XOR-linked: a node is its value plus a single link word, and the
+ * bucket array packs the head and the tail of each chain, so a chain can be walked, and unlinked at, from either end.
+ * Nodes come from a `xor_slab_allocator` by default, which places them contiguously without per-node allocation
+ * headers.
+ * Notes: Like all XOR-linked structures, an iterator holds its node and its predecessor in the chain, and is
+ * invalidated when that predecessor is erased.
+ */
+export template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+				 class Allocator = xor_slab_allocator<std::pair<const Key, T>>>
+class xor_unordered_map {
+  public:
+	// Member types
+	using key_type = Key;
+	using mapped_type = T;
+	using value_type = std::pair<const Key, T>;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+	using allocator_type = Allocator;
+	using reference = value_type &;
+	using const_reference = const value_type &;
+
+  private:
+	struct _node {
+		_node *_link; // XOR of the previous and next nodes of the chain, null past either end
+		value_type _value;
+	};
+
+	struct _bucket {
+		_node *_head = nullptr;
+		_node *_tail = nullptr;
+	};
+
+	using __node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_node>;
+	using __node_alloc_traits = std::allocator_traits<__node_allocator>;
+	using __bucket_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_bucket>;
+
+	static _node *__xor(_node *a, _node *b) noexcept {
+		return reinterpret_cast<_node *>(reinterpret_cast<std::uintptr_t>(a) ^ reinterpret_cast<std::uintptr_t>(b));
+	}
+
+	// iterator
+	template <bool Const> class __iterator {
+		using __bucket_pointer = std::conditional_t<Const, const _bucket *, _bucket *>;
+
+		__bucket_pointer _at, _last; // bucket of `_cur`, `_at == _last` at the end
+		_node *_prev, *_cur;
+
+		__iterator(__bucket_pointer at, __bucket_pointer last, _node *prev, _node *cur) noexcept
+			: _at(at), _last(last), _prev(prev), _cur(cur) {}
+
+		// Moves to the head of the first non-empty bucket from `_at` on.
+		void __settle() noexcept {
+			while (_cur == nullptr && _at != _last)
+				if (++_at != _last)
+					_cur = _at->_head;
+		}
+
+		friend class xor_unordered_map;
+		template <bool> friend class __iterator;
+
+	  public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = xor_unordered_map::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+		using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+		__iterator() noexcept : _at(), _last(), _prev(), _cur() {}
+		template <bool C, class = std::enable_if_t<Const && !C>>
+		__iterator(const __iterator<C> &it) noexcept : _at(it._at), _last(it._last), _prev(it._prev), _cur(it._cur) {}
+
+		reference operator*() const noexcept { return _cur->_value; }
+		pointer operator->() const noexcept { return std::addressof(_cur->_value); }
+		__iterator &operator++() noexcept {
+			_prev = std::exchange(_cur, __xor(_cur->_link, _prev));
+
+			if (_cur == nullptr) {
+				_prev = nullptr;
+				__settle();
+			}
+
+			return *this;
+		}
+		__iterator operator++(int) noexcept {
+			auto tmp = *this;
+			++(*this);
+			return tmp;
+		}
+		bool operator==(const __iterator &rhs) const noexcept { return _cur == rhs._cur; }
+	};
+
+  public:
+	using iterator = __iterator<false>;
+	using const_iterator = __iterator<true>;
+
+  private:
+	std::vector<_bucket, __bucket_allocator> _buckets; // a power of two, or empty
+	int _bits = 0;
+	size_type _size = 0;
+	float _max_load_factor = 1.0f;
+	[[no_unique_address]] __node_allocator _alloc;
+	[[no_unique_address]] hasher _hash;
+	[[no_unique_address]] key_equal _equal;
+
+	/* Member functions */
+
+  public:
+	xor_unordered_map() = default;
+
+	/*
+	 * Constructs an empty container with at least `bucket_count` buckets.
+	 * Parameters:
+	 *   - bucket_count: minimal number of buckets to use on initialization
+	 *   - hash: hash function to use
+	 *   - equal: comparison function to use for all key comparisons of this container
+	 *   - alloc: allocator to use for all memory allocations of this container
+	 * Complexity: Linear in `bucket_count`
+	 */
+	explicit xor_unordered_map(size_type bucket_count, const hasher &hash = hasher(),
+							   const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type())
+		: _buckets(__bucket_allocator(alloc)), _alloc(alloc), _hash(hash), _equal(equal) {
+		rehash(bucket_count);
+	}
+
+	xor_unordered_map(std::initializer_list<value_type> init) {
+		reserve(init.size());
+
+		for (const value_type &value : init)
+			insert(value);
+	}
+
+	/*
+	 * Copy constructor. The allocator is obtained by calling `select_on_container_copy_construction` on the one of
+	 * `other`, which gives the copy slabs of its own with the default `xor_slab_allocator`.
+	 * Complexity: Linear in size of `other`
+	 */
+	xor_unordered_map(const xor_unordered_map &other)
+		: _buckets(__bucket_allocator(__node_alloc_traits::select_on_container_copy_construction(other._alloc))),
+		  _max_load_factor(other._max_load_factor), _alloc(_buckets.get_allocator()), _hash(other._hash),
+		  _equal(other._equal) {
+		reserve(other.size());
+
+		for (const value_type &value : other)
+			insert(value);
+	}
+
+	xor_unordered_map(xor_unordered_map &&other) noexcept
+		: _buckets(std::move(other._buckets)), _bits(std::exchange(other._bits, 0)),
+		  _size(std::exchange(other._size, 0)), _max_load_factor(other._max_load_factor), _alloc(other._alloc),
+		  _hash(std::move(other._hash)), _equal(std::move(other._equal)) {
+		other._buckets.clear();
+	}
+
+	~xor_unordered_map() { clear(); }
+
+	xor_unordered_map &operator=(const xor_unordered_map &other) {
+		if (this != std::addressof(other)) {
+			xor_unordered_map copy(other);
+			swap(copy);
+		}
+
+		return *this;
+	}
+
+	xor_unordered_map &operator=(xor_unordered_map &&other) noexcept {
+		if (this != std::addressof(other)) {
+			xor_unordered_map moved(std::move(other));
+			swap(moved);
+		}
+
+		return *this;
+	}
+
+	allocator_type get_allocator() const noexcept { return allocator_type(_alloc); }
+
+	/* Iterators */
+
+	iterator begin() noexcept {
+		if (_size == 0)
+			return end();
+
+		iterator it(_buckets.data(), _buckets.data() + _buckets.size(), nullptr, _buckets.front()._head);
+		it.__settle();
+		return it;
+	}
+
+	const_iterator begin() const noexcept { return const_cast<xor_unordered_map &>(*this).begin(); }
+	const_iterator cbegin() const noexcept { return begin(); }
+	iterator end() noexcept { return iterator(); }
+	const_iterator end() const noexcept { return const_iterator(); }
+	const_iterator cend() const noexcept { return end(); }
+
+	/* Capacity */
+
+	[[nodiscard]] bool empty() const noexcept { return _size == 0; }
+
+	size_type size() const noexcept { return _size; }
+
+	/* Modifiers */
+
+	/*
+	 * Destroys all the elements, chain by chain. The buckets are kept.
+	 * Complexity: Linear in the size of the container and in the number of buckets
+	 */
+	void clear() noexcept {
+		for (_bucket &bucket : _buckets) {
+			for (_node *prev = nullptr, *cur = bucket._head; cur != nullptr;) {
+				_node *const next = __xor(cur->_link, prev);
+				prev = cur;
+				__destroy_node(cur);
+				cur = next;
+			}
+
+			bucket = _bucket();
+		}
+
+		_size = 0;
+	}
+
+	/*
+	 * If a key equivalent to `key` already exists, does nothing. Otherwise inserts an element constructed in place from
+	 * `key` and `args...` at the tail of its bucket.
+	 * Return value: A pair of the iterator to the element with key `key` and `true` if the insertion took place.
+	 * Complexity: Amortized constant on average, linear in the size of the container when a rehash occurs
+	 */
+	template <class... Args> std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+		return __try_emplace(key, std::forward<Args>(args)...);
+	}
+
+	template <class... Args> std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+		return __try_emplace(std::move(key), std::forward<Args>(args)...);
+	}
+
+	std::pair<iterator, bool> insert(const value_type &value) { return try_emplace(value.first, value.second); }
+
+	template <class M> std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj) {
+		auto result = try_emplace(key, std::forward<M>(obj));
+
+		if (!result.second)
+			result.first->second = std::forward<M>(obj);
+
+		return result;
+	}
+
+	/*
+	 * Removes the element at `pos`. The iterator already knows the predecessor of the node, so no chain walk is needed.
+	 * Return value: Iterator following the removed element.
+	 * Complexity: Constant
+	 */
+	iterator erase(const_iterator pos) {
+		_bucket *const bucket = const_cast<_bucket *>(pos._at);
+		_node *const next = __xor(pos._cur->_link, pos._prev);
+
+		__unlink(*bucket, pos._prev, pos._cur, next);
+		__destroy_node(pos._cur);
+		--_size;
+
+		iterator it(bucket, _buckets.data() + _buckets.size(), next == nullptr ? nullptr : pos._prev, next);
+		it.__settle();
+		return it;
+	}
+
+	/*
+	 * Removes the element with a key equivalent to `key`, if any. The chain is searched from both ends at once, so keys
+	 * near the tail, such as the most recently inserted ones, are found as fast as keys near the head.
+	 * Return value: Number of elements removed (0 or 1).
+	 * Complexity: Constant on average
+	 */
+	size_type erase(const key_type &key) {
+		if (_size == 0)
+			return 0;
+
+		_bucket &bucket = _buckets[__index(key)];
+
+		for (_node *hp = nullptr, *h = bucket._head, *tn = nullptr, *t = bucket._tail; h != nullptr;) {
+			if (_equal(h->_value.first, key)) {
+				__unlink(bucket, hp, h, __xor(h->_link, hp));
+				__destroy_node(h);
+				--_size;
+				return 1;
+			}
+			if (_equal(t->_value.first, key)) {
+				__unlink(bucket, __xor(t->_link, tn), t, tn);
+				__destroy_node(t);
+				--_size;
+				return 1;
+			}
+			if (h == t || __xor(h->_link, hp) == t)
+				break;
+
+			hp = std::exchange(h, __xor(h->_link, hp));
+			tn = std::exchange(t, __xor(t->_link, tn));
+		}
+
+		return 0;
+	}
+
+	void swap(xor_unordered_map &other) noexcept {
+		using std::swap;
+		swap(_buckets, other._buckets);
+		swap(_bits, other._bits);
+		swap(_size, other._size);
+		swap(_max_load_factor, other._max_load_factor);
+		swap(_alloc, other._alloc);
+		swap(_hash, other._hash);
+		swap(_equal, other._equal);
+	}
+
+	/* Lookup */
+
+	/*
+	 * Returns a reference to the mapped value of the element with key equivalent to `key`.
+	 * Exceptions: `std::out_of_range` if the container does not have an element with the specified key.
+	 * Complexity: Constant on average
+	 */
+	mapped_type &at(const key_type &key) {
+		const iterator it = find(key);
+
+		if (it == end())
+			throw std::out_of_range("xor_unordered_map::at: key not found");
+
+		return it->second;
+	}
+
+	const mapped_type &at(const key_type &key) const { return const_cast<xor_unordered_map &>(*this).at(key); }
+
+	mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+
+	mapped_type &operator[](key_type &&key) { return try_emplace(std::move(key)).first->second; }
+
+	/*
+	 * Finds the element with key equivalent to `key`.
+	 * Return value: Iterator to the element, or `end()` if no such element is found.
+	 * Complexity: Constant on average
+	 */
+	iterator find(const key_type &key) {
+		if (_size == 0)
+			return end();
+
+		_bucket &bucket = _buckets[__index(key)];
+
+		for (_node *prev = nullptr, *cur = bucket._head; cur != nullptr;) {
+			if (_equal(cur->_value.first, key))
+				return iterator(std::addressof(bucket), _buckets.data() + _buckets.size(), prev, cur);
+
+			prev = std::exchange(cur, __xor(cur->_link, prev));
+		}
+
+		return end();
+	}
+
+	const_iterator find(const key_type &key) const { return const_cast<xor_unordered_map &>(*this).find(key); }
+
+	size_type count(const key_type &key) const { return find(key) != end(); }
+
+	bool contains(const key_type &key) const { return find(key) != end(); }
+
+	/* Bucket interface */
+
+	size_type bucket_count() const noexcept { return _buckets.size(); }
+
+	size_type bucket_size(size_type n) const {
+		size_type count = 0;
+
+		for (_node *prev = nullptr, *cur = _buckets[n]._head; cur != nullptr; ++count)
+			prev = std::exchange(cur, __xor(cur->_link, prev));
+
+		return count;
+	}
+
+	/* Hash policy */
+
+	float load_factor() const noexcept { return _buckets.empty() ? 0.0f : float(_size) / float(_buckets.size()); }
+
+	float max_load_factor() const noexcept { return _max_load_factor; }
+
+	void max_load_factor(float ml) {
+		_max_load_factor = std::max(ml, 0.125f);
+		reserve(_size);
+	}
+
+	/*
+	 * Rebuilds the buckets with at least `count` of them, and at least enough to respect the maximum load factor. Nodes
+	 * are relinked, never reallocated.
+	 * Complexity: Linear in the size of the container and in the number of buckets
+	 */
+	void rehash(size_type count) {
+		count = std::max<size_type>(count, static_cast<size_type>(float(_size) / _max_load_factor) + 1);
+
+		const int bits = std::max<int>(1, std::bit_width(count - 1));
+		std::vector<_bucket, __bucket_allocator> buckets(std::size_t(1) << bits, _bucket(),
+														 __bucket_allocator(_alloc));
+
+		std::swap(buckets, _buckets);
+		_bits = bits;
+
+		for (_bucket &bucket : buckets)
+			for (_node *prev = nullptr, *cur = bucket._head; cur != nullptr;) {
+				_node *const next = __xor(cur->_link, prev);
+				prev = cur;
+				__link_tail(_buckets[__index(cur->_value.first)], cur);
+				cur = next;
+			}
+	}
+
+	void reserve(size_type count) {
+		if (count > 0 && float(count) > _max_load_factor * float(_buckets.size()))
+			rehash(static_cast<size_type>(float(count) / _max_load_factor) + 1);
+	}
+
+	/* Observers */
+
+	hasher hash_function() const { return _hash; }
+
+	key_equal key_eq() const { return _equal; }
+
+  private:
+	// Fibonacci hashing: spreads identity-like hashes over the `_bits` high bits of the product.
+	std::size_t __index(const key_type &key) const noexcept {
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ull) >>
+										(64 - _bits));
+	}
+
+	static void __link_tail(_bucket &bucket, _node *x) noexcept {
+		x->_link = bucket._tail;
+
+		if (bucket._tail == nullptr)
+			bucket._head = x;
+		else
+			bucket._tail->_link = __xor(bucket._tail->_link, x);
+
+		bucket._tail = x;
+	}
+
+	// Unlinks `x` from between `prev` and `next`, either of which is null at an end of the chain.
+	static void __unlink(_bucket &bucket, _node *prev, _node *x, _node *next) noexcept {
+		if (prev == nullptr)
+			bucket._head = next;
+		else
+			prev->_link = __xor(prev->_link, __xor(x, next));
+
+		if (next == nullptr)
+			bucket._tail = prev;
+		else
+			next->_link = __xor(next->_link, __xor(x, prev));
+	}
+
+	void __destroy_node(_node *x) noexcept {
+		__node_alloc_traits::destroy(_alloc, std::addressof(x->_value));
+		__node_alloc_traits::deallocate(_alloc, x, 1);
+	}
+
+	template <class K, class... Args> std::pair<iterator, bool> __try_emplace(K &&key, Args &&...args) {
+		if (const iterator it = find(key); it != end())
+			return {it, false};
+
+		reserve(_size + 1);
+
+		_node *const x = __node_alloc_traits::allocate(_alloc, 1);
+
+		try {
+			__node_alloc_traits::construct(_alloc, std::addressof(x->_value), std::piecewise_construct,
+										   std::forward_as_tuple(std::forward<K>(key)),
+										   std::forward_as_tuple(std::forward<Args>(args)...));
+		} catch (...) {
+			__node_alloc_traits::deallocate(_alloc, x, 1);
+			throw;
+		}
+
+		_bucket &bucket = _buckets[__index(x->_value.first)];
+		_node *const prev = bucket._tail;
+		__link_tail(bucket, x);
+		++_size;
+
+		return {iterator(std::addressof(bucket), _buckets.data() + _buckets.size(), prev, x), true};
+	}
+};
+
+/* Non - member functions */
+
+export template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+void swap(xor_unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs,
+		  xor_unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs) noexcept {
+	lhs.swap(rhs);
+}
+
+export template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Pred>
+typename xor_unordered_map<Key, T, Hash, KeyEqual, Alloc>::size_type
+erase_if(xor_unordered_map<Key, T, Hash, KeyEqual, Alloc> &c, Pred pred) {
+	typename xor_unordered_map<Key, T, Hash, KeyEqual, Alloc>::size_type count = 0;
+
+	for (auto it = c.begin(); it != c.end();)
+		if (pred(*it)) {
+			it = c.erase(it);
+			++count;
+		} else
+			++it;
+
+	return count;
+}
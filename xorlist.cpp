@@ -5,14 +5,20 @@
 export module xorlist;
 
 import <cstddef>;
+import <cstdint>;
 
 import <algorithm>;
+import <bit>;
+import <functional>;
 import <iterator>;
 import <limits>;
 import <memory>;
+import <ranges>;
+import <span>;
 import <stdexcept>;
 import <type_traits>;
 import <utility>;
+import <vector>;
 
 /**
  - [x] list() noexcept(is_nothrow_default_constructible<allocator_type>::value);
@@ -65,23 +71,24 @@ import <utility>;
  - [x] size_type max_size() const noexcept;
  */
 /**
- - [ ] void clear() noexcept;
- - [ ] iterator insert(const_iterator position, const value_type& x);
- - [ ] iterator insert(const_iterator position, value_type&& x);
+ - [x] void clear() noexcept;
+ - [x] iterator insert(const_iterator position, const value_type& x);
+ - [x] iterator insert(const_iterator position, value_type&& x);
  - [ ] iterator insert(const_iterator position, size_type n, const value_type& x);
  - [ ] template <class Iter> iterator insert(const_iterator position, Iter first, Iter last);
  - [x] iterator insert(const_iterator position, initializer_list<value_type> il);
- - [ ] template <class... Args> iterator emplace(const_iterator position, Args&&... args);
- - [ ] iterator erase(const_iterator position);
- - [ ] iterator erase(const_iterator position, const_iterator last);
- - [ ] void push_back(const value_type& x);
- - [ ] void push_back(value_type&& x);
- - [ ] template <class... Args> reference emplace_back(Args&&... args);  // reference in C++17
- - [ ] void pop_back();
- - [ ] void push_front(const value_type& x);
- - [ ] void push_front(value_type&& x);
- - [ ] template <class... Args> reference emplace_front(Args&&... args); // reference in C++17
- - [ ] void pop_front();
+ - [x] template <class... Args> iterator emplace(const_iterator position, Args&&... args);
+ - [x] iterator erase(const_iterator position);
+ - [x] iterator erase(const_iterator position, const_iterator last);
+ - [x] void push_back(const value_type& x);
+ - [x] void push_back(value_type&& x);
+ - [x] template <class... Args> reference emplace_back(Args&&... args);  // reference in C++17
+ - [x] template <container-compatible-range<T> R> void append_range(R&& rg); // C++23
+ - [x] void pop_back();
+ - [x] void push_front(const value_type& x);
+ - [x] void push_front(value_type&& x);
+ - [x] template <class... Args> reference emplace_front(Args&&... args); // reference in C++17
+ - [x] void pop_front();
  - [ ] void resize(size_type sz);
  - [ ] void resize(size_type sz, const value_type& c);
  - [ ] void swap(list&) noexcept(allocator_traits<allocator_type>::is_always_equal::value);  // C++17
@@ -89,21 +96,44 @@ import <utility>;
 /**
  - [x] void merge(list& x);
  - [x] void merge(list&& x);
- - [ ] template <class Compare> void merge(list& x, Compare comp);
+ - [x] template <class Compare> void merge(list& x, Compare comp);
  - [x] template <class Compare> void merge(list&& x, Compare comp);
- - [ ] void splice(const_iterator position, list& x);
+ - [x] void splice(const_iterator position, list& x);
  - [x] void splice(const_iterator position, list&& x);
- - [ ] void splice(const_iterator position, list& x, const_iterator i);
+ - [x] void splice(const_iterator position, list& x, const_iterator i);
  - [x] void splice(const_iterator position, list&& x, const_iterator i);
- - [ ] void splice(const_iterator position, list& x, const_iterator first, const_iterator last);
+ - [x] void splice(const_iterator position, list& x, const_iterator first, const_iterator last);
  - [x] void splice(const_iterator position, list&& x, const_iterator first, const_iterator last);
  - [x] size_type remove(const value_type& value);
  - [x] template <class Pred> size_type remove_if(Pred pred);
  - [x] void reverse() noexcept;
  - [x] size_type unique();
  - [x] template <class BinaryPredicate> size_type unique(BinaryPredicate binary_pred);
+ - [x] template <class Hash, class KeyEqual> size_type unique_unsorted(Hash hash, KeyEqual equal);
  - [x] void sort();
- - [ ] template <class Compare> void sort(Compare comp);
+ - [x] template <class Compare> void sort(Compare comp);
+ */
+/**
+ - [x] template <class Compare> iterator insert_sorted(const value_type& value, Compare comp);
+ - [x] template <class Compare> iterator insert_sorted(value_type&& value, Compare comp);
+ - [x] template <class InputIt, class Compare> void insert_sorted_batch(InputIt first, InputIt last, Compare comp);
+ */
+/**
+ - [x] template <class Compare> iterator partial_sort(size_type k, Compare comp);
+ - [x] template <class UnaryPredicate> iterator partition(UnaryPredicate pred);
+ - [x] template <class UnaryPredicate> iterator stable_partition(UnaryPredicate pred);
+ - [x] template <class UnaryPredicate> void partition_into(UnaryPredicate pred, xorlist& yes, xorlist& no);
+ - [x] template <class KeyFn> void distribute(KeyFn key_fn, span<xorlist> buckets);
+ - [x] template <class Compare> xorlist set_union_into(xorlist& other, xorlist& out, Compare comp);
+ - [x] template <class Compare> xorlist set_intersection_into(xorlist& other, xorlist& out, Compare comp);
+ - [x] template <class Compare> xorlist set_difference_into(xorlist& other, xorlist& out, Compare comp);
+ - [x] template <class Compare> xorlist set_symmetric_difference_into(xorlist& other, xorlist& out, Compare comp);
+ - [x] template <class Compare> iterator nth_element(size_type n, Compare comp);
+ */
+/**
+ - [x] float max_dead_ratio() const noexcept;
+ - [x] void max_dead_ratio(float ratio) noexcept;
+ - [x] void purge() noexcept;
  */
 /*
  - [x] template<class T, class Alloc> bool operator==(const list<T, Alloc>& lhs, const list<T, Alloc>& rhs);
@@ -133,92 +163,129 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	using pointer = std::allocator_traits<Allocator>::pointer;
 	using void_pointer = std::allocator_traits<Allocator>::void_pointer;
 	using const_pointer = std::allocator_traits<Allocator>::const_pointer;
+  private:
+	// node
+	template <class T> struct _node;
+	using __alloc_traits = std::allocator_traits<allocator_type>;
+	using __node_allocator = typename __alloc_traits::template rebind_alloc<_node<T>>;
+	using __node_alloc_traits = std::allocator_traits<__node_allocator>;
+	using __node_pointer = typename __node_alloc_traits::pointer;
+	using __buffer_allocator = typename __alloc_traits::template rebind_alloc<__node_pointer>;
+	using __node_buffer = std::vector<__node_pointer, __buffer_allocator>; // scratch space of bulk operations
+	std::pair<size_type, __node_allocator> __size_alloc_;
+	__node_allocator &__node_alloc() noexcept { return __size_alloc_.second; }
+	const __node_allocator &__node_alloc() const noexcept { return __size_alloc_.second; }
+
 	// iterator
 	// https://gist.github.com/jeetsukumaran/307264
+	// A position in a XOR list is a pair of adjacent nodes: the link of `_cur` only yields its successor once its
+	// predecessor is known. Dead (tombstoned) nodes are skipped in both directions.
   public:
 	class iterator {
 	  private:
-		pointer ptr;
+		__node_pointer _prev, _cur;
 
-	  public:
-		using iterator_category = std::forward_iterator_tag;
+		iterator(__node_pointer prev, __node_pointer cur) noexcept : _prev(prev), _cur(cur) {}
 
-		iterator() noexcept : ptr() {}
-		iterator(pointer ptr) : ptr(ptr) {}
-		[[nodiscard]] reference operator*() const noexcept { return *ptr; }
+		friend class xorlist;
+
+	  public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = xorlist::pointer;
+		using reference = xorlist::reference;
+
+		iterator() noexcept : _prev(), _cur() {}
+		[[nodiscard]] reference operator*() const noexcept { return _cur->_value; }
 		[[nodiscard]] pointer operator->() const noexcept { return std::pointer_traits<pointer>::pointer_to(**this); }
-		auto operator++() {
-			ptr++;
+		iterator &operator++() noexcept {
+			do {
+				const __node_pointer next = __next_node(_prev, _cur);
+				_prev = _cur;
+				_cur = next;
+			} while (__is_dead(_cur));
 			return *this;
 		}
-		auto operator++(int) {
+		iterator operator++(int) noexcept {
 			auto tmp = *this;
 			++(*this);
 			return tmp;
 		}
-		auto operator--() {
-			ptr--;
+		iterator &operator--() noexcept {
+			do {
+				const __node_pointer prev = __next_node(_cur, _prev);
+				_cur = _prev;
+				_prev = prev;
+			} while (__is_dead(_cur));
 			return *this;
 		}
-		auto operator--(int) {
+		iterator operator--(int) noexcept {
 			auto tmp = *this;
 			--(*this);
 			return tmp;
 		}
-		bool operator==(const iterator &rhs) const { return ptr == rhs.ptr; };
+		bool operator==(const iterator &rhs) const noexcept { return _cur == rhs._cur; };
 	};
 
 	class const_iterator {
 	  private:
-		pointer ptr;
+		__node_pointer _prev, _cur;
 
-	  public:
-		using iterator_category = std::forward_iterator_tag;
+		const_iterator(__node_pointer prev, __node_pointer cur) noexcept : _prev(prev), _cur(cur) {}
 
-		const_iterator() noexcept : ptr() {}
-		const_iterator(pointer ptr) : ptr(ptr) {}
-		const_reference operator*() const noexcept { return ptr; }
-		const_pointer operator->() const noexcept { return std::pointer_traits<pointer>::pointer_to(**this); }
-		auto operator++() {
+		friend class xorlist;
+
+	  public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = xorlist::const_pointer;
+		using reference = xorlist::const_reference;
+
+		const_iterator() noexcept : _prev(), _cur() {}
+		const_iterator(const iterator &it) noexcept : _prev(it._prev), _cur(it._cur) {}
+		const_reference operator*() const noexcept { return _cur->_value; }
+		const_pointer operator->() const noexcept { return std::pointer_traits<const_pointer>::pointer_to(**this); }
+		const_iterator &operator++() noexcept {
+			do {
+				const __node_pointer next = __next_node(_prev, _cur);
+				_prev = _cur;
+				_cur = next;
+			} while (__is_dead(_cur));
+			return *this;
+		}
+		const_iterator operator++(int) noexcept {
 			auto tmp = *this;
 			++(*this);
 			return tmp;
 		}
-		auto operator++(int) {
-			ptr++;
-			return *this;
-		}
-		auto operator--() {
-			ptr--;
+		const_iterator &operator--() noexcept {
+			do {
+				const __node_pointer prev = __next_node(_cur, _prev);
+				_cur = _prev;
+				_prev = prev;
+			} while (__is_dead(_cur));
 			return *this;
 		}
-		auto operator--(int) {
+		const_iterator operator--(int) noexcept {
 			auto tmp = *this;
 			--(*this);
 			return tmp;
 		}
-		bool operator==(const const_iterator &rhs) { return ptr == rhs.ptr; }
+		bool operator==(const const_iterator &rhs) const noexcept { return _cur == rhs._cur; }
 	};
 	using reverse_iterator = std::reverse_iterator<iterator>;
 	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
   private:
-	// node
-	template <class T> struct _node;
-	using __alloc_traits = std::allocator_traits<allocator_type>;
-	using __node_allocator = typename __alloc_traits::template rebind_alloc<_node<T>>;
-	using __node_alloc_traits = std::allocator_traits<__node_allocator>;
-	using __node_pointer = typename __node_alloc_traits::pointer;
-	std::pair<size_type, __node_allocator> __size_alloc_;
-	__node_allocator &__node_alloc() noexcept { return __size_alloc_.second; }
-	const __node_allocator &__node_alloc() const noexcept { return __size_alloc_.second; }
-
 	template <class T> struct _node {
 		using __node_pointer = typename std::pointer_traits<void_pointer>::template rebind<_node<T>>;
 		__node_pointer _link;
 		T _value;
 
-		_node() : _link(_self()) {}
+		// an unlinked node (or the sentinel of an empty ring) has both neighbours equal, hence a null link
+		_node() : _link(nullptr) {}
 
 		__node_pointer _self() { return std::pointer_traits<__node_pointer>::pointer_to(*this); }
 
@@ -229,8 +296,12 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 
 	pointer front0 = nullptr, front1 = nullptr, back0 = nullptr, back1 = nullptr;
 	Allocator alloc;
-	size_type _size{};
+	size_type _size{}; // live elements only
+	size_type _dead{}; // tombstoned nodes still linked in the ring
+	float _max_dead_ratio = 0.0f; // 0 disables tombstoning
 	_node<value_type> _end;
+	__node_pointer _head = _end._self(); // first node of the ring, `_end` itself when empty
+	__node_pointer _finger_prev{}, _finger{}; // position of the last `insert_sorted`, null when unknown
 
 	/* Member functions */
 
@@ -247,7 +318,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 *   - alloc: allocator to use for all memory allocations of this container
 	 * Complexity: Constant
 	 */
-	explicit xorlist(const allocator_type &alloc) : alloc(alloc) {}
+	explicit xorlist(const allocator_type &alloc) : __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {}
 
 	/**
 	 * Constructs the container with count copies of elements with value value.
@@ -257,7 +328,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear in `count`
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
-	xorlist(size_type count, const value_type &value, const Allocator &alloc = Allocator()) : alloc(alloc) {
+	xorlist(size_type count, const value_type &value, const Allocator &alloc = Allocator())
+		: __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {
 		for (; count > 0; --count)
 			push_back(value);
 	}
@@ -272,7 +344,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear in `count`
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
-	explicit xorlist(size_type count, const Allocator &alloc = Allocator()) : alloc(alloc) {
+	explicit xorlist(size_type count, const Allocator &alloc = Allocator())
+		: __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {
 		for (; count > 0; --count)
 			emplace_back();
 	}
@@ -288,7 +361,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
 	template <class InputIt /*, std::enable_if_t<std::iterator_traits<InputIt>::value, bool> = true */>
-	xorlist(InputIt first, InputIt last, const Allocator &alloc = Allocator()) : alloc(alloc) {
+	xorlist(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+		: __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {
 		for (; first != last; ++first)
 			emplace_back(*first);
 	}
@@ -302,7 +376,9 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear in size of `other`
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
-	xorlist(const xorlist &other) {
+	xorlist(const xorlist &other)
+		: __size_alloc_(0, __node_alloc_traits::select_on_container_copy_construction(other.__node_alloc())),
+		  alloc(other.get_allocator()) {
 		for (const_iterator i = other.begin(), e = other.end(); i != e; ++i)
 			push_back(*i);
 	}
@@ -316,7 +392,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear in size of `other`
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
-	xorlist(const xorlist &other, const Allocator &alloc) : alloc(alloc) {
+	xorlist(const xorlist &other, const Allocator &alloc) : __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {
 		for (const_iterator i = other.begin(), e = other.end(); i != e; ++i)
 			push_back(*i);
 	}
@@ -332,7 +408,10 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * blanket statement in [[container.rev.reqmts]/17](http://eel.is/c++draft/container.rev.reqmts#17), and a more
 	 * direct guarantee is under consideration via [LWG 2321](https://cplusplus.github.io/LWG/issue2321).
 	 */
-	xorlist(xorlist &&other) noexcept(std::is_nothrow_move_constructible<T>::value) { splice(end(), other); }
+	xorlist(xorlist &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+		: __size_alloc_(0, other.__node_alloc()), alloc(other.alloc) {
+		splice(end(), other);
+	}
 
 	/**
 	 * Allocator-extended move constructor. Using alloc as the allocator for the new container, moving the contents from
@@ -344,7 +423,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear if `alloc != other.get_allocator()`, otherwise constant
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
-	xorlist(xorlist &&other, const Allocator &alloc) : alloc(alloc) {
+	xorlist(xorlist &&other, const Allocator &alloc) : __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {
 		if (alloc == other.get_allocator())
 			splice(end(), other);
 		else {
@@ -361,7 +440,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear in size of `init`
 	 * Exceptions: Calls to `Allocator::allocate` may throw.
 	 */
-	xorlist(std::initializer_list<value_type> init, const Allocator &alloc = Allocator()) : alloc(alloc) {
+	xorlist(std::initializer_list<value_type> init, const Allocator &alloc = Allocator())
+		: __size_alloc_(0, __node_allocator(alloc)), alloc(alloc) {
 		for (typename std::initializer_list<value_type>::const_iterator i = init.begin(), e = init.end(); i != e; ++i)
 			push_back(*i);
 	}
@@ -503,7 +583,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 */
 	reference front() {
 		assert(!empty(), "xorlist::front called on empty xorlist");
-		return *(end()++);
+		return *begin();
 	}
 
 	/*
@@ -514,7 +594,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 */
 	const_reference front() const {
 		assert(!empty(), "xorlist::front called on empty xorlist");
-		return *(end()++);
+		return *begin();
 	}
 
 	/*
@@ -525,7 +605,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 */
 	reference back() {
 		assert(!empty(), "xorlist::back called on empty xorlist");
-		return *(end()--);
+		return *std::prev(end());
 	}
 
 	/*
@@ -536,7 +616,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 */
 	const_reference back() const {
 		assert(!empty(), "xorlist::back called on empty xorlist");
-		return *(end()--);
+		return *std::prev(end());
 	}
 
 	/* Iterators */
@@ -545,13 +625,13 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Returns an iterator to the first element of the list. If the list is empty, the returned iterator will be equal
 	 * to `end()`. Return value: Iterator to the first element. Complexity: Constant.
 	 */
-	iterator begin() noexcept { iterator(end()++, this); }
+	iterator begin() noexcept { return ++end(); }
 
 	/*
 	 * Returns an iterator to the first element of the list. If the list is empty, the returned iterator will be equal
 	 * to `end()`. Return value: Iterator to the first element. Complexity: Constant.
 	 */
-	const_iterator begin() const noexcept { const_iterator(end()++, this); }
+	const_iterator begin() const noexcept { return ++end(); }
 
 	/*
 	 * Returns an iterator to the first element of the list. If the list is empty, the returned iterator will be equal
@@ -564,14 +644,14 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * attempting to access it results in undefined behavior. Return value: Iterator to the element following the last
 	 * element. Complexity: Constant.
 	 */
-	iterator end() noexcept { return iterator(end); }
+	iterator end() noexcept { return iterator(__last_node(), __end_node()); }
 
 	/*
 	 * Returns an iterator to the element following the last element of the list. This element acts as a placeholder;
 	 * attempting to access it results in undefined behavior. Return value: Iterator to the element following the last
 	 * element. Complexity: Constant.
 	 */
-	const_iterator end() const noexcept { return const_iterator(end); }
+	const_iterator end() const noexcept { return const_iterator(__last_node(), __end_node()); }
 
 	/*
 	 * Returns an iterator to the element following the last element of the list. This element acts as a placeholder;
@@ -661,20 +741,23 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Linear in the size of the container, i.e., the number of elements.
 	 */
 	void clear() noexcept {
-		if (!empty()) {
+		if (_size + _dead != 0) {
 			__node_allocator &__na = __node_alloc();
+			const __node_pointer __s = __end_node();
+
+			for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s;) {
+				const __node_pointer __next = __next_node(__prev, __cur);
+				__prev = __cur;
+				__cur = __next;
+				__node_alloc_traits::destroy(__na, std::addressof(__prev->_value));
+				__node_alloc_traits::deallocate(__na, __prev, 1);
+			}
 
-			__node_pointer __f = _end._link;
-			__node_pointer __l = __f;
-			__unlink_nodes(__f, __l--);
+			_end._link = nullptr;
+			_head = __s;
+			__drop_finger();
 			_size = 0;
-
-			while (__f != __l) {
-				__node_pointer __np = __f->_as_node();
-				__f = __f->_link;
-				__node_alloc_traits::destroy(__na, std::addressof(__np->_value));
-				__node_alloc_traits::deallocate(__na, __np, 1);
-			}
+			_dead = 0;
 		}
 	}
 
@@ -686,11 +769,12 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Type requirements:
 	 *   - T must meet the requirements of [CopyInsertable](https://en.cppreference.com/w/cpp/named_req/CopyInsertable)
 	 * in order to use overload Return value: Iterator pointing to the inserted value Complexity: Constant. Exceptions:
-	 * If an exception is thrown, there are no effects (strong exception guarantee). Notes: No iterators or references
-	 * are invalidated.
+	 * If an exception is thrown, there are no effects (strong exception guarantee). Notes: No references are
+	 * invalidated; iterators equal to `pos` are, since an iterator holds the node preceding its element, which is now
+	 * the new one.
 	 */
 	iterator insert(const_iterator pos, const value_type &value) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		return emplace(pos, value);
 	}
 
 	/*
@@ -701,11 +785,12 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Type requirements:
 	 *   - T must meet the requirements of [MoveInsertable](https://en.cppreference.com/w/cpp/named_req/MoveInsertable)
 	 * in order to use overload Return value: Iterator pointing to the inserted value Complexity: Constant. Exceptions:
-	 * If an exception is thrown, there are no effects (strong exception guarantee). Notes: No iterators or references
-	 * are invalidated.
+	 * If an exception is thrown, there are no effects (strong exception guarantee). Notes: No references are
+	 * invalidated; iterators equal to `pos` are, since an iterator holds the node preceding its element, which is now
+	 * the new one.
 	 */
 	iterator insert(const_iterator pos, value_type &&value) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		return emplace(pos, std::move(value));
 	}
 
 	/*
@@ -719,7 +804,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * and [CopyInsertable](https://en.cppreference.com/w/cpp/named_req/CopyInsertable) in order to use overload Return
 	 * value: Iterator pointing to the first element inserted, or pos if `count==0` Complexity: Linear in `count`
 	 * Exceptions: If an exception is thrown, there are no effects (strong exception guarantee).
-	 * Notes: No iterators or references are invalidated.
+	 * Notes: No references are invalidated; iterators equal to `pos` are, since an iterator holds the node preceding
+	 * its element, which is now the last one inserted.
 	 */
 	iterator insert(const_iterator pos, size_type count, const value_type &value) {
 		throw std::logic_error::logic_error("Not yet implemented");
@@ -738,7 +824,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Return value: Iterator pointing to the first element inserted, or `pos` if `first==last`.
 	 * Complexity: Linear in `std::distance(first, last)`
 	 * Exceptions: If an exception is thrown, there are no effects (strong exception guarantee).
-	 * Notes: No iterators or references are invalidated.
+	 * Notes: No references are invalidated; iterators equal to `pos` are, since an iterator holds the node preceding
+	 * its element, which is now the last one inserted.
 	 */
 	template <class InputIt> iterator insert(const_iterator pos, InputIt first, InputIt last) {
 		throw std::logic_error::logic_error("Not yet implemented");
@@ -754,7 +841,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Return value: Iterator pointing to the first element inserted, or `pos` if `ilist` is empty.
 	 * Complexity: Linear in `ilist.size()`
 	 * Exceptions: If an exception is thrown, there are no effects (strong exception guarantee).
-	 * Notes: No iterators or references are invalidated.
+	 * Notes: No references are invalidated; iterators equal to `pos` are, since an iterator holds the node preceding
+	 * its element, which is now the last one inserted.
 	 */
 	iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
 		return insert(pos, ilist.begin(), ilist.end());
@@ -765,7 +853,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * [`std::allocator_traits::construct`](https://en.cppreference.com/w/cpp/memory/allocator_traits/construct), which
 	 * uses placement-new to construct the element in-place at a location provided by the container. The arguments
 	 * `args...` are forwarded to the constructor as `std::forward<Args>(args)...`. `args...` may directly or indirectly
-	 * refer to a value in the container. No iterators or references are invalidated. Parameters:
+	 * refer to a value in the container. No references are invalidated; iterators equal to `pos` are, since an iterator
+	 * holds the node preceding its element, which is now the new one. Parameters:
 	 *   - pos: iterator before which the new element will be constructed
 	 *   - args: arguments to forward to the constructor of the element
 	 * Type requirements:
@@ -775,7 +864,11 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * left unmodified, as if this function was never called (strong exception guarantee).
 	 */
 	template <class... Args> iterator emplace(const_iterator pos, Args &&...args) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		const __node_pointer __x = __create_node(std::forward<Args>(args)...);
+		__link_node(pos._prev, __x, pos._cur);
+		++_size;
+
+		return iterator(pos._prev, __x);
 	}
 
 	/*
@@ -785,7 +878,7 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Return value: Iterator following the last removed element. If `pos` refers to the last element, then the `end()`
 	 * iterator is returned. Complexity: Constant.
 	 */
-	iterator erase(const_iterator pos) { throw std::logic_error::logic_error("Not yet implemented"); }
+	iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
 
 	/*
 	 * Removes the elements in the range `[first, last)`. References and iterators to the erased elements are
@@ -798,14 +891,47 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * last)` is an empty range, then `last` is returned. Complexity: Linear in the distance between `first` and `last`.
 	 */
 	iterator erase(const_iterator first, const_iterator last) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		__node_pointer __p = first._prev, __x = first._cur;
+		const __node_pointer __l = last._cur;
+
+		if (!__lazy_erase()) {
+			__node_pointer __dead = nullptr; // unlinked nodes, chained through `_link`
+
+			while (__x != __l) {
+				const __node_pointer __n = __next_node(__p, __x);
+				__unlink_node(__p, __x, __n);
+				__x->_link = __dead;
+				__dead = __x;
+				--_size;
+				__x = __n;
+			}
+
+			__destroy_chain(__dead);
+
+			return iterator(__p, __l);
+		}
+
+		while (__x != __l) {
+			const __node_pointer __n = __next_node(__p, __x);
+
+			if (!__is_dead(__x)) {
+				__mark_dead(__x);
+				--_size;
+				++_dead;
+			}
+
+			__p = __x;
+			__x = __n;
+		}
+
+		return iterator(__compact(__p, __l), __l);
 	}
 
 	/*
 	 * Appends the given element value to the end of the container. The new element is initialized as a copy of value.
-	 * No iterators or references are invalidated.
+	 * No references are invalidated; the `end()` iterators are, since the element preceding the end changes.
 	 * Parameters:
-	 *   - value: the value of the element to prepend
+	 *   - value: the value of the element to append
 	 * Type requirements:
 	 *   - `T` must meet the requirements of
 	 * [CopyInsertable](https://en.cppreference.com/w/cpp/named_req/CopyInsertable) in order to use Complexity:
@@ -813,13 +939,15 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * constructor/assignment), this function has no effect ([strong exception
 	 * guarantee](https://en.cppreference.com/w/cpp/language/exceptions#Exception_safety)).
 	 */
-	void push_back(const value_type &value) { throw std::logic_error::logic_error("Not yet implemented"); }
+	void push_back(const value_type &value) {
+		emplace(end(), value);
+	}
 
 	/*
 	 * Appends the given element value to the end of the container. `value` is moved into the new element.
-	 * No iterators or references are invalidated.
+	 * No references are invalidated; the `end()` iterators are, since the element preceding the end changes.
 	 * Parameters:
-	 *   - value: the value of the element to prepend
+	 *   - value: the value of the element to append
 	 * Type requirements:
 	 *   - `T` must meet the requirements of
 	 * [MoveInsertable](https://en.cppreference.com/w/cpp/named_req/MoveInsertable) in order to use Complexity:
@@ -827,14 +955,16 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * constructor/assignment), this function has no effect ([strong exception
 	 * guarantee](https://en.cppreference.com/w/cpp/language/exceptions#Exception_safety)).
 	 */
-	void push_back(value_type &&value) { throw std::logic_error::logic_error("Not yet implemented"); }
+	void push_back(value_type &&value) {
+		emplace(end(), std::move(value));
+	}
 
 	/*
 	 * Appends a new element to the end of the container. The element is constructed through
 	 * `std::allocator_traits::construct`, which typically uses placement-new to construct the element in-place at the
 	 * location provided by the container. The arguments `args...` are forwarded to the constructor as
-	 * `[std::forward](http://en.cppreference.com/w/cpp/utility/forward)<Args>(args)...`. No iterators or references are
-	 * invalidated. Parameters:
+	 * `[std::forward](http://en.cppreference.com/w/cpp/utility/forward)<Args>(args)...`. No references are invalidated;
+	 * the `end()` iterators are, since the element preceding the end changes. Parameters:
 	 *   - args: arguments to forward to the constructor of the element
 	 * Type requirements:
 	 *   - `T` (the container's element type) must meet the requirements of
@@ -843,7 +973,32 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * no effect (strong exception guarantee).
 	 */
 	template <class... Args> reference emplace_back(Args &&...args) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		return *emplace(end(), std::forward<Args>(args)...);
+	}
+
+	/*
+	 * Appends copies or moves of the elements of `rg`, in order. Unlike the iterator-pair overloads, `rg` may end with
+	 * a sentinel of another type, e.g. a generator or a lazy view, and is traversed exactly once, so it is never
+	 * materialized. The new nodes are chained apart and linked in a single splice.
+	 * Parameters:
+	 *   - rg: input range whose elements `T` can be constructed from
+	 * Complexity: Linear in the number of elements of `rg`.
+	 * Exceptions: If an exception is thrown, this function has no effect (strong exception guarantee).
+	 */
+	template <std::ranges::input_range R>
+		requires std::constructible_from<value_type, std::ranges::range_reference_t<R>>
+	void append_range(R &&rg) {
+		__chain __c;
+
+		try {
+			for (auto &&__v : rg)
+				__c.__push_back(__create_node(std::forward<decltype(__v)>(__v)));
+		} catch (...) {
+			__destroy_chain(__thread_chain(__c));
+			throw;
+		}
+
+		__append_chain(__c);
 	}
 
 	/*
@@ -853,34 +1008,42 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Constant.
 	 * Exceptions: Throws nothing.
 	 */
-	void pop_back() { throw std::logic_error::logic_error("Not yet implemented"); }
+	void pop_back() {
+		erase(std::prev(end()));
+	}
 
 	/*
-	 * Prepends the given element value to the beginning of the container. No iterators or references are invalidated.
+	 * Prepends the given element value to the beginning of the container. No references are invalidated; iterators to
+	 * the former first element, such as `begin()`, are, since the element preceding it changes.
 	 * Parameters:
 	 *   - value: the value of the element to prepend
 	 * Complexity: Constant.
 	 * Exceptions: If an exception is thrown, this function has no effect ([strong exception
 	 * guarantee](https://en.cppreference.com/w/cpp/language/exceptions#Exception_safety)).
 	 */
-	void push_front(const value_type &value) { throw std::logic_error::logic_error("Not yet implemented"); }
+	void push_front(const value_type &value) {
+		emplace(begin(), value);
+	}
 
 	/*
-	 * Prepends the given element value to the beginning of the container. No iterators or references are invalidated.
+	 * Prepends the given element value to the beginning of the container. No references are invalidated; iterators to
+	 * the former first element, such as `begin()`, are, since the element preceding it changes.
 	 * Parameters:
 	 *   - value: the value of the element to prepend
 	 * Complexity: Constant.
 	 * Exceptions: If an exception is thrown, this function has no effect ([strong exception
 	 * guarantee](https://en.cppreference.com/w/cpp/language/exceptions#Exception_safety)).
 	 */
-	void push_front(value_type &&value) { throw std::logic_error::logic_error("Not yet implemented"); }
+	void push_front(value_type &&value) {
+		emplace(begin(), std::move(value));
+	}
 
 	/*
 	 * Inserts a new element to the beginning of the container. The element is constructed through
 	 * `std::allocator_traits::construct`, which typically uses placement-new to construct the element in-place at the
 	 * location provided by the container. The arguments `args...` are forwarded to the constructor as
-	 * `[std::forward](http://en.cppreference.com/w/cpp/utility/forward)<Args>(args)...`. No iterators or references are
-	 * invalidated. Parameters:
+	 * `[std::forward](http://en.cppreference.com/w/cpp/utility/forward)<Args>(args)...`. No references are invalidated;
+	 * iterators to the former first element, such as `begin()`, are. Parameters:
 	 *   - args: arguments to forward to the constructor of the element
 	 * Type requirements
 	 *   - `T` must meet the requirements of
@@ -889,14 +1052,16 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * no effect (strong exception guarantee).
 	 */
 	template <class... Args> reference emplace_front(Args &&...args) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		return *emplace(begin(), std::forward<Args>(args)...);
 	}
 
 	/*
 	 * Removes the first element of the container. If there are no elements in the container, the behavior is undefined.
 	 * References and iterators to the erased element are invalidated. Complexity: Constant. Exceptions: Does not throw.
 	 */
-	void pop_front() { throw std::logic_error::logic_error("Not yet implemented"); }
+	void pop_front() {
+		erase(begin());
+	}
 
 	/*
 	 * Resizes the container to contain `count` elements.
@@ -950,11 +1115,11 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	/*
 	 * The function does nothing if `other` refers to the same object as `*this`.
 	 * Otherwise, merges two sorted lists into one. The lists should be sorted into ascending order. No elements are
-	 * copied. The container `other` becomes empty after the operation. No iterators or references become invalidated,
-	 * except that the iterators of moved elements now refer into `*this`, not into `other`. Uses `operator<` to compare
-	 * the elements. This operation is stable: for equivalent elements in the two lists, the elements from `*this` shall
-	 * always precede the elements from `other`, and the order of equivalent elements of `*this` and `other` does not
-	 * change. If `get_allocator() != * other.get_allocator()`, the behavior is undefined. Parameters:
+	 * copied. The container `other` becomes empty after the operation. No references become invalidated; iterators
+	 * are when the element preceding theirs changes, which is the case of the moved elements. Uses `operator<` to
+	 * compare the elements. This operation is stable: for equivalent elements in the two lists, the elements from
+	 * `*this` shall always precede the elements from `other`, and the order of equivalent elements of `*this` and
+	 * `other` does not change. If `get_allocator() != * other.get_allocator()`, the behavior is undefined. Parameters:
 	 *   - other: another container to merge
 	 * Exceptions: If an exception is thrown, this function has no effect (strong exception guarantee), except if the
 	 * exception comes from a comparison. Complexity: If `other refers to the same object as `*this`, no comparisons are
@@ -966,11 +1131,11 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	/*
 	 * The function does nothing if `other` refers to the same object as `*this`.
 	 * Otherwise, merges two sorted lists into one. The lists should be sorted into ascending order. No elements are
-	 * copied. The container `other` becomes empty after the operation. No iterators or references become invalidated,
-	 * except that the iterators of moved elements now refer into `*this`, not into `other`. Uses `operator<` to compare
-	 * the elements. This operation is stable: for equivalent elements in the two lists, the elements from `*this` shall
-	 * always precede the elements from `other`, and the order of equivalent elements of `*this` and `other` does not
-	 * change. If `get_allocator() != * other.get_allocator()`, the behavior is undefined. Parameters:
+	 * copied. The container `other` becomes empty after the operation. No references become invalidated; iterators
+	 * are when the element preceding theirs changes, which is the case of the moved elements. Uses `operator<` to
+	 * compare the elements. This operation is stable: for equivalent elements in the two lists, the elements from
+	 * `*this` shall always precede the elements from `other`, and the order of equivalent elements of `*this` and
+	 * `other` does not change. If `get_allocator() != * other.get_allocator()`, the behavior is undefined. Parameters:
 	 *   - other: another container to merge
 	 * Exceptions: If an exception is thrown, this function has no effect (strong exception guarantee), except if the
 	 * exception comes from a comparison. Complexity: If `other refers to the same object as `*this`, no comparisons are
@@ -982,8 +1147,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	/*
 	 * The function does nothing if `other` refers to the same object as `*this`.
 	 * Otherwise, merges two sorted lists into one. The lists should be sorted into ascending order. No elements are
-	 copied. The container `other` becomes empty after the operation. No iterators or references become invalidated,
-	 except that the iterators of moved elements now refer into `*this`, not into `other`. Uses  the given comparison
+	 copied. The container `other` becomes empty after the operation. No references become invalidated; iterators
+	 are when the element preceding theirs changes, which is the case of the moved elements. Uses the given comparison
 	 function `comp` to compare the elements.
 	 * This operation is stable: for equivalent elements in the two lists, the elements from `*this` shall always
 	 precede the elements from `other`, and the order of equivalent elements of `*this` and `other` does not change.
@@ -1008,14 +1173,35 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 at most $M + N - 1$ comparisons using `comp`
 	 */
 	template <class Compare> void merge(xorlist &other, Compare comp) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		if (this == std::addressof(other))
+			return;
+
+		if (other._dead != 0)
+			other.purge();
+
+		iterator __pos = begin();
+
+		while (!other.empty()) {
+			while (__pos != end() && !comp(other.front(), *__pos))
+				++__pos;
+
+			if (__pos == end()) {
+				splice(end(), other);
+				return;
+			}
+
+			const __node_pointer __x = other.__pop_front_node();
+			__link_node(__pos._prev, __x, __pos._cur);
+			__pos._prev = __x; // still before the same element
+			++_size;
+		}
 	}
 
 	/*
 	 * The function does nothing if `other` refers to the same object as `*this`.
 	 * Otherwise, merges two sorted lists into one. The lists should be sorted into ascending order. No elements are
-	 copied. The container `other` becomes empty after the operation. No iterators or references become invalidated,
-	 except that the iterators of moved elements now refer into `*this`, not into `other`. Uses  the given comparison
+	 copied. The container `other` becomes empty after the operation. No references become invalidated; iterators
+	 are when the element preceding theirs changes, which is the case of the moved elements. Uses the given comparison
 	 function `comp` to compare the elements.
 	 * This operation is stable: for equivalent elements in the two lists, the elements from `*this` shall always
 	 precede the elements from `other`, and the order of equivalent elements of `*this` and `other` does not change.
@@ -1045,22 +1231,36 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Transfers all elements from `other` into `*this`. The elements are inserted before the element pointed to by
 	 * `pos`. The container `other` becomes empty after the operation. The behavior is undefined if `other` refers to
 	 * the same object as `*this`. No elements are copied or moved, only the internal pointers of the list nodes are
-	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No iterators or references
-	 * become invalidated, the iterators to moved elements remain valid, but now refer into `*this`, not into `other`.
+	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No references become
+	 * invalidated, and references to moved elements now refer into `*this`. Since an iterator holds the node preceding
+	 * its element, the iterators whose preceding element changes are invalidated: `pos`, the iterators to the first
+	 * moved element, and the `end()` iterators of `other`.
 	 * Parameters:
 	 *   - pos: element before which the content will be inserted
 	 *   - other: another container to transfer the content from
 	 * Exceptions: Throws nothing.
 	 * Complexity: Constant
 	 */
-	void splice(const_iterator pos, xorlist &other) { throw std::logic_error::logic_error("Not yet implemented"); }
+	void splice(const_iterator pos, xorlist &other) {
+		if (other._dead != 0)
+			other.purge();
+
+		if (!other.empty()) {
+			const __node_pointer __f = other.__first_node(), __l = other.__last_node();
+			other.__unlink_range(other.__end_node(), __f, __l, other.__end_node());
+			__link_range(pos._prev, __f, __l, pos._cur);
+			_size += std::exchange(other._size, 0);
+		}
+	}
 
 	/*
 	 * Transfers all elements from `other` into `*this`. The elements are inserted before the element pointed to by
 	 * `pos`. The container `other` becomes empty after the operation. The behavior is undefined if `other` refers to
 	 * the same object as `*this`. No elements are copied or moved, only the internal pointers of the list nodes are
-	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No iterators or references
-	 * become invalidated, the iterators to moved elements remain valid, but now refer into `*this`, not into `other`.
+	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No references become
+	 * invalidated, and references to moved elements now refer into `*this`. Since an iterator holds the node preceding
+	 * its element, the iterators whose preceding element changes are invalidated: `pos`, the iterators to the first
+	 * moved element, and the `end()` iterators of `other`.
 	 * Parameters:
 	 *   - pos: element before which the content will be inserted
 	 *   - other: another container to transfer the content from
@@ -1072,8 +1272,10 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	/*
 	 * Transfers the element pointed to by `it` from `other` into `*this`. The element is inserted before the element
 	 * pointed to by `pos`. No elements are copied or moved, only the internal pointers of the list nodes are
-	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No iterators or references
-	 * become invalidated, the iterators to moved elements remain valid, but now refer into `*this`, not into `other`.
+	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No references become
+	 * invalidated, and references to the moved element now refer into `*this`. Since an iterator holds the node
+	 * preceding its element, the iterators whose preceding element changes are invalidated: `pos`, `it`, and the
+	 * iterators to the element which followed `it` in `other`.
 	 * Parameters:
 	 *   - pos: element before which the content will be inserted
 	 *   - other: another container to transfer the content from
@@ -1082,14 +1284,24 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Constant
 	 */
 	void splice(const_iterator pos, xorlist &other, const_iterator it) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		const __node_pointer __x = it._cur;
+
+		if (pos._cur == __x || pos._prev == __x)
+			return;
+
+		other.__unlink_node(it._prev, __x, __next_node(it._prev, __x));
+		__link_node(pos._prev, __x, pos._cur);
+		--other._size;
+		++_size;
 	}
 
 	/*
 	 * Transfers the element pointed to by `it` from `other` into `*this`. The element is inserted before the element
 	 * pointed to by `pos`. No elements are copied or moved, only the internal pointers of the list nodes are
-	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No iterators or references
-	 * become invalidated, the iterators to moved elements remain valid, but now refer into `*this`, not into `other`.
+	 * re-pointed. The behavior is undefined if: `get_allocator() != other.get_allocator()`. No references become
+	 * invalidated, and references to the moved element now refer into `*this`. Since an iterator holds the node
+	 * preceding its element, the iterators whose preceding element changes are invalidated: `pos`, `it`, and the
+	 * iterators to the element which followed `it` in `other`.
 	 * Parameters:
 	 *   - pos: element before which the content will be inserted
 	 *   - other: another container to transfer the content from
@@ -1103,8 +1315,9 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Transfers the elements in the range `[first, last)` from `other` into `*this`. The elements are inserted before
 	 * the element pointed to by `pos`. The behavior is undefined if `pos` is an iterator in the range `[first,last)`.
 	 * No elements are copied or moved, only the internal pointers of the list nodes are re-pointed. The behavior is
-	 * undefined if: `get_allocator() != other.get_allocator()`. No iterators or references become invalidated, the
-	 * iterators to moved elements remain valid, but now refer into `*this`, not into `other`. Parameters:
+	 * undefined if: `get_allocator() != other.get_allocator()`. No references become invalidated, and references to
+	 * moved elements now refer into `*this`. Since an iterator holds the node preceding its element, the iterators
+	 * whose preceding element changes are invalidated: `pos`, `first` and `last`. Parameters:
 	 *   - pos: element before which the content will be inserted
 	 *   - other: another container to transfer the content from
 	 *   - first, last: the range of elements to transfer from `other` to `*this`
@@ -1113,15 +1326,39 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * last)`.
 	 */
 	void splice(const_iterator pos, xorlist &other, const_iterator first, const_iterator last) {
-		throw std::logic_error::logic_error("Not yet implemented");
+		if (first == last || pos == first || pos == last)
+			return;
+
+		const __node_pointer __f = first._cur, __l = last._prev;
+
+		if (this != std::addressof(other)) {
+			size_type __live = 0, __dead = 0;
+
+			for (__node_pointer __prev = first._prev, __cur = __f; __prev != __l;) {
+				++(__is_dead(__cur) ? __dead : __live);
+				__prev = std::exchange(__cur, __next_node(__prev, __cur));
+			}
+
+			other._size -= __live;
+			other._dead -= __dead;
+			_size += __live;
+			_dead += __dead;
+		}
+
+		other.__unlink_range(first._prev, __f, __l, last._cur);
+		__link_range(pos._prev, __f, __l, pos._cur);
+
+		if (_dead != 0 && !__lazy_erase())
+			purge();
 	}
 
 	/*
 	 * Transfers the elements in the range `[first, last)` from `other` into `*this`. The elements are inserted before
 	 * the element pointed to by `pos`. The behavior is undefined if `pos` is an iterator in the range `[first,last)`.
 	 * No elements are copied or moved, only the internal pointers of the list nodes are re-pointed. The behavior is
-	 * undefined if: `get_allocator() != other.get_allocator()`. No iterators or references become invalidated, the
-	 * iterators to moved elements remain valid, but now refer into `*this`, not into `other`. Parameters:
+	 * undefined if: `get_allocator() != other.get_allocator()`. No references become invalidated, and references to
+	 * moved elements now refer into `*this`. Since an iterator holds the node preceding its element, the iterators
+	 * whose preceding element changes are invalidated: `pos`, `first` and `last`. Parameters:
 	 *   - pos: element before which the content will be inserted
 	 *   - other: another container to transfer the content from
 	 *   - first, last: the range of elements to transfer from `other` to `*this`
@@ -1141,24 +1378,8 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * Complexity: Linear in the size of the container
 	 */
 	size_type remove(const value_type &value) {
-		xorlist<value_type, Allocator> deleted_nodes(get_allocator()); // collect the nodes we're removing
-
-		for (const_iterator i = begin(), e = end(); i != e;) {
-			if (*i == value) {
-				const_iterator j = std::next(i);
-
-				for (; j != e && *j == value; ++j)
-					;
-				deleted_nodes.splice(deleted_nodes.end(), *this, i, j);
-				i = j;
-
-				if (i != e)
-					++i;
-			} else
-				++i;
-		}
-
-		return deleted_nodes.size();
+		// `value` may alias an element of `*this`: nodes are only destroyed once the whole pass is over
+		return remove_if([&](const value_type &__v) { return __v == value; });
 	}
 
 	/*
@@ -1171,43 +1392,65 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * `v`. Thus, a parameter type of `T&` is not allowed, nor is `T` unless for `T` a move is equivalent to a copy.
 	 * Return value: The number of elements removed.
 	 * Complexity: Linear in the size of the container
+	 * Exceptions: If `p` throws, the elements it selected before are removed and the others are kept.
 	 */
 	template <class UnaryPredicate> size_type remove_if(UnaryPredicate p) {
-		xorlist<value_type, Allocator> deleted_nodes(get_allocator()); // collect the nodes we're removing
-
-		for (iterator i = begin(), e = end(); i != e;) {
-			if (p(*i)) {
-				iterator j = std::next(i);
+		const __node_pointer __s = __end_node();
+		const bool __lazy = __lazy_erase();
+		__node_pointer __dead = nullptr; // unlinked nodes, chained through `_link`
+		size_type __count = 0;
+
+		try {
+			for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s;) {
+				const __node_pointer __next = __next_node(__prev, __cur);
+
+				if (__is_dead(__cur) || !p(__cur->_value))
+					__prev = __cur;
+				else if (__lazy) {
+					__mark_dead(__cur);
+					__prev = __cur;
+					++__count;
+				} else {
+					__unlink_node(__prev, __cur, __next);
+					__cur->_link = __dead;
+					__dead = __cur;
+					++__count;
+				}
+
+				__cur = __next;
+			}
+		} catch (...) {
+			// the elements removed before `p` threw stay removed
+			_size -= __count;
 
-				for (; j != e && p(*j); ++j)
-					;
-				deleted_nodes.splice(deleted_nodes.end(), *this, i, j);
-				i = j;
+			if (__lazy)
+				_dead += __count;
+			else
+				__destroy_chain(__dead);
 
-				if (i != e)
-					++i;
-			} else
-				++i;
+			throw;
 		}
 
-		return deleted_nodes.size();
+		_size -= __count;
+
+		if (__lazy) {
+			_dead += __count;
+			__compact(__s, __s);
+		} else
+			__destroy_chain(__dead);
+
+		return __count;
 	}
 
 	/*
-	 * Reverses the order of the elements in the container. No references or iterators become invalidated.
-	 * Complexity: Linear in the size of the container
+	 * Reverses the order of the elements in the container. A node links to both of its neighbours through the same XOR
+	 * word, so the ring reads the same in both directions: the last node just becomes the head, and no node is touched.
+	 * No references become invalidated; iterators are, since the pair of nodes they hold now walks the list backwards.
+	 * Complexity: Constant
 	 */
 	void reverse() noexcept {
-		if (_size > 1) {
-			iterator e = end();
-
-			for (iterator i = begin(); *i != *e;) {
-				std::swap((*i)--, (*i)++);
-				*i = (*i)--;
-			}
-
-			std::swap((*e)--, (*e)++);
-		}
+		__drop_finger();
+		_head = __last_node();
 	}
 
 	/*
@@ -1233,23 +1476,75 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * object of type `xorlist<T,Allocator>::const_iterator` can be dereferenced and then implicitly converted to both
 	 * of them. Return value: The number of elements removed. Complexity: Exactly `size() - 1` comparisons of the
 	 * elements, if the container is not empty. Otherwise, no comparison is performed.
+	 * Exceptions: If `p` throws, the duplicates found before are removed and the others are kept.
 	 */
 	template <class BinaryPredicate> size_type unique(BinaryPredicate p) {
-		xorlist<value_type, Allocator> deleted_nodes(get_allocator()); // collect the nodes we're removing
+		if (_dead != 0)
+			purge();
+
+		const __node_pointer __s = __end_node();
+		__node_pointer __dead = nullptr; // unlinked nodes, chained through `_link`
+		size_type __count = 0;
+
+		try {
+			// `__prev` is always the last kept element, i.e. the first element of the current group
+			for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s;) {
+				const __node_pointer __next = __next_node(__prev, __cur);
+
+				if (__prev != __s && p(__prev->_value, __cur->_value)) {
+					__unlink_node(__prev, __cur, __next);
+					__cur->_link = __dead;
+					__dead = __cur;
+					++__count;
+				} else
+					__prev = __cur;
+
+				__cur = __next;
+			}
+		} catch (...) {
+			// the elements removed before `p` threw stay removed
+			_size -= __count;
+			__destroy_chain(__dead);
+			throw;
+		}
 
-		for (iterator i = begin(), e = end(); i != e;) {
-			iterator j = std::next(i);
+		_size -= __count;
+		__destroy_chain(__dead);
 
-			for (; j != e && p(*i, *j); ++j)
-				;
+		return __count;
+	}
 
-			if (++i != j) {
-				deleted_nodes.splice(deleted_nodes.end(), *this, i, j);
-				i = j;
+	/*
+	 * Removes all duplicate elements from the container, consecutive or not. Only the first occurrence of each value is
+	 * left and the relative order of the remaining elements is preserved. Elements already seen are kept in an
+	 * open-addressing hash set of element addresses, allocated through the container's allocator. Parameters:
+	 *   - hash: hash function object consistent with `equal`
+	 *   - equal: binary predicate which returns `true` if the elements should be treated as equal
+	 * Return value: The number of elements removed.
+	 * Complexity: Linear in the size of the container on average, one call to `hash` per element.
+	 * Notes: Unlike `sort()` followed by `unique()`, this does not require `operator<` and keeps the original order.
+	 */
+	template <class Hash = std::hash<value_type>, class KeyEqual = std::equal_to<value_type>>
+	size_type unique_unsorted(Hash hash = Hash(), KeyEqual equal = KeyEqual()) {
+		if (_size < 2)
+			return 0;
+
+		using __slot_allocator = typename __alloc_traits::template rebind_alloc<const value_type *>;
+		// linear probing, at most half full
+		const int __bits = std::bit_width(2 * _size - 1);
+		const std::size_t __mask = (std::size_t(1) << __bits) - 1;
+		std::vector<const value_type *, __slot_allocator> __seen(__mask + 1, nullptr, __slot_allocator(__node_alloc()));
+
+		return remove_if([&](const value_type &__v) {
+			for (std::size_t __i = __hash_slot(hash(__v), __bits);; __i = (__i + 1) & __mask) {
+				if (__seen[__i] == nullptr) {
+					__seen[__i] = std::addressof(__v);
+					return false;
+				}
+				if (equal(*__seen[__i], __v))
+					return true;
 			}
-		}
-
-		return deleted_nodes.size();
+		});
 	}
 
 	/*
@@ -1277,19 +1572,833 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 	 * category](https://en.cppreference.com/w/cpp/language/value_category) (thus, `Type1 &` is not allowed, nor is
 	 * `Type1` unless for `Type1` a move is equivalent to a copy). The types `Type1` and `Type2` must be such that an
 	 * object of type `xorlist<T,Allocator>::const_iterator` can be dereferenced and then implicitly converted to both
-	 * of them. Complexity: Approximately `N log N` comparisons, where `N` is the number of elements* in the list.
+	 * of them. Complexity: Approximately `N log N` comparisons, where `N` is the number of elements* in the list, and
+	 * `N - 1` if the list is already sorted. No memory is allocated.
 	 * Notes:
 	 * [`std::sort`](https://en.cppreference.com/w/cpp/algorithm/sort) requires random access iterators and so cannot be
 	 * used with list. This function also differs from [`std::sort`](https://en.cppreference.com/w/cpp/algorithm/sort)
-	 * in that it does not require the element type of the list to be swappable, preserves the values of all iterators,
-	 * and performs a stable sort.
+	 * in that it does not require the element type of the list to be swappable, and performs a stable sort. The nodes
+	 * are merged bottom-up through at most 64 runs of `2^i` nodes each, relinking them: no element is copied or moved,
+	 * so references remain valid, but iterators, which hold the neighbouring node, are invalidated. If `comp` throws,
+	 * every node is linked back into the list, in an unspecified order.
+	 */
+	template <class Compare> void sort(Compare comp) {
+		if (_dead != 0)
+			purge();
+
+		const __node_pointer __s = __end_node();
+		const auto __before = [&](__node_pointer __a, __node_pointer __b) { return comp(__a->_value, __b->_value); };
+
+		bool __sorted = true;
+
+		for (__node_pointer __prev = __s, __cur = __first_node(); __sorted && __cur != __s;) {
+			const __node_pointer __next = __next_node(__prev, __cur);
+
+			__sorted = __next == __s || !__before(__next, __cur);
+			__prev = std::exchange(__cur, __next);
+		}
+
+		if (__sorted)
+			return;
+
+		// __runs[i] is empty or holds 2^i sorted nodes, all preceding those of __runs[j] for j < i
+		__chain __rest{__first_node(), __last_node(), std::exchange(_size, 0)};
+		__chain __runs[64], __carry, __merged;
+		size_type __fill = 0;
+
+		__unlink_range(__s, __rest._first, __rest._last, __s);
+
+		try {
+			while (__rest._size != 0) {
+				__carry.__push_back(__rest.__pop_front());
+				size_type __i = 0;
+
+				for (; __i < __fill && __runs[__i]._size != 0; ++__i) {
+					__merge_chains(__runs[__i], __carry, __merged, __before);
+					__carry = std::exchange(__merged, __chain{});
+				}
+
+				__runs[__i] = std::exchange(__carry, __chain{});
+				__fill = std::max(__fill, __i + 1);
+			}
+
+			for (size_type __i = 0; __i < __fill; ++__i) {
+				__merge_chains(__runs[__i], __carry, __merged, __before);
+				__carry = std::exchange(__merged, __chain{});
+			}
+		} catch (...) {
+			__append_chain(__rest);
+			__append_chain(__carry);
+			__append_chain(__merged);
+
+			for (__chain &__run : __runs)
+				__append_chain(__run);
+
+			throw;
+		}
+
+		__append_chain(__carry);
+	}
+
+	/* Sorted insertion */
+
+	/*
+	 * Inserts `value` into the list, which must be sorted with respect to `comp`, after the elements equivalent to it.
+	 * The search starts from the element inserted by the previous `insert_sorted`, the finger, and walks left or right
+	 * from there; without a valid finger it starts from the back. The finger is forgotten when a modification of the
+	 * list touches it.
+	 * Parameters:
+	 *   - value: element value to insert
+	 *   - comp: comparison function object which returns `true` if the first argument is ordered before the second
+	 * Return value: Iterator pointing to the inserted `value`.
+	 * Complexity: Linear in the distance between the finger (or the back) and the insertion position, so nearly
+	 * ordered streams of inserts cost amortized constant time per element.
+	 */
+	template <class Compare = std::less<value_type>>
+	iterator insert_sorted(const value_type &value, Compare comp = Compare()) {
+		return __insert_sorted(value, comp);
+	}
+
+	template <class Compare = std::less<value_type>>
+	iterator insert_sorted(value_type &&value, Compare comp = Compare()) {
+		return __insert_sorted(std::move(value), comp);
+	}
+
+	/*
+	 * Inserts the elements of `[first, last)` into the list, which must be sorted with respect to `comp`. The new nodes
+	 * are created up front, stably sorted unless the range already is, and merged into the list in a single relinking
+	 * pass. Equivalent elements are inserted after those already in the list and keep their relative order.
+	 * Parameters:
+	 *   - first, last: the range of elements to insert
+	 *   - comp: comparison function object which returns `true` if the first argument is ordered before the second
+	 * Complexity: Linear in `size() + std::distance(first, last)`, plus `M log M` comparisons if the `M` new elements
+	 * are not sorted. The batch needs a buffer of `M` node pointers.
+	 * Exceptions: If an exception is thrown while creating or sorting the nodes, this function has no effect. If `comp`
+	 * throws while they are merged, the elements already linked stay inserted and the others are destroyed.
+	 */
+	template <class InputIt, class Compare = std::less<value_type>>
+	void insert_sorted_batch(InputIt first, InputIt last, Compare comp = Compare()) {
+		__node_buffer __batch{__buffer_allocator(__node_alloc())};
+		const auto __before = [&](__node_pointer __a, __node_pointer __b) { return comp(__a->_value, __b->_value); };
+
+		try {
+			for (; first != last; ++first) {
+				const __node_pointer __x = __create_node(*first);
+
+				try {
+					__batch.push_back(__x);
+				} catch (...) {
+					__destroy_chain(__x);
+					throw;
+				}
+			}
+
+			if (!std::is_sorted(__batch.begin(), __batch.end(), __before))
+				std::stable_sort(__batch.begin(), __batch.end(), __before);
+		} catch (...) {
+			__destroy_buffer(__batch.data(), __batch.data() + __batch.size());
+			throw;
+		}
+
+		iterator __pos = begin();
+		auto __it = __batch.begin();
+
+		try {
+			for (; __it != __batch.end(); ++__it) {
+				while (__pos != end() && !comp((*__it)->_value, *__pos))
+					++__pos;
+
+				__link_node(__pos._prev, *__it, __pos._cur);
+				__pos._prev = *__it; // still before the same element
+				++_size;
+			}
+		} catch (...) {
+			__destroy_buffer(std::to_address(__it), __batch.data() + __batch.size());
+			throw;
+		}
+	}
+
+	/* Partitioning */
+
+	/*
+	 * Reorders the elements so that those for which `pred` returns `true` precede those for which it returns `false`.
+	 * In a single pass, the rejected nodes are unlinked into a detached chain, which is linked back at the end; both
+	 * groups thus keep their relative order. No element is copied or moved and nothing is allocated.
+	 * Parameters:
+	 *   - pred: unary predicate which returns `true` for the elements that go first
+	 * Return value: Iterator to the first element of the second group, or `end()` if there is none.
+	 * Complexity: Exactly `size()` applications of `pred`.
+	 * Exceptions: If `pred` throws, the elements are left in an unspecified order, but none is lost.
+	 */
+	template <class UnaryPredicate> iterator stable_partition(UnaryPredicate pred) {
+		if (_dead != 0)
+			purge();
+
+		const __node_pointer __s = __end_node();
+		__chain __rejected;
+
+		try {
+			for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s;) {
+				const __node_pointer __next = __next_node(__prev, __cur);
+
+				if (pred(__cur->_value))
+					__prev = __cur;
+				else {
+					__unlink_node(__prev, __cur, __next);
+					__rejected.__push_back(__cur);
+				}
+
+				__cur = __next;
+			}
+		} catch (...) {
+			if (__rejected._first != nullptr)
+				__link_range(__last_node(), __rejected._first, __rejected._last, __s);
+			throw;
+		}
+
+		if (__rejected._first == nullptr)
+			return end();
+
+		const __node_pointer __last = __last_node();
+		__link_range(__last, __rejected._first, __rejected._last, __s);
+
+		return iterator(__last, __rejected._first);
+	}
+
+	/*
+	 * Same as `stable_partition`: relinking nodes in a single pass is as cheap as any unstable partition.
+	 */
+	template <class UnaryPredicate> iterator partition(UnaryPredicate pred) { return stable_partition(pred); }
+
+	/*
+	 * Moves every element into `yes` if `pred` returns `true` for it, into `no` otherwise, appending it at the back of
+	 * the target and preserving the relative order. `*this` becomes empty. The nodes are relinked, never copied, moved
+	 * nor reallocated. If `get_allocator()` differs from the allocator of a target, the behavior is undefined.
+	 * Parameters:
+	 *   - pred: unary predicate which returns `true` for the elements that go to `yes`
+	 *   - yes, no: target lists, distinct from `*this`, possibly the same list
+	 * Complexity: Exactly `size()` applications of `pred`, and constant work per element.
+	 * Exceptions: If `pred` throws, the elements already classified are in their target, the others in `*this`.
+	 */
+	template <class UnaryPredicate> void partition_into(UnaryPredicate pred, xorlist &yes, xorlist &no) {
+		if (_dead != 0)
+			purge();
+
+		const __node_pointer __s = __end_node();
+		__chain __yes, __no;
+
+		try {
+			while (_head != __s) {
+				const bool __match = pred(_head->_value);
+				(__match ? __yes : __no).__push_back(__pop_front_node());
+			}
+		} catch (...) {
+			yes.__append_chain(__yes);
+			no.__append_chain(__no);
+			throw;
+		}
+
+		yes.__append_chain(__yes);
+		no.__append_chain(__no);
+	}
+
+	/*
+	 * Moves every element to the back of `buckets[key_fn(x)]`, in a single pass over the list, which becomes empty.
+	 * Each bucket receives its elements in their original order, so distributing by successive digits and splicing
+	 * the buckets back yields a radix sort. The nodes are relinked, never copied, moved nor reallocated, and no memory
+	 * is allocated. If `get_allocator()` differs from the allocator of a bucket, the behavior is undefined.
+	 * Parameters:
+	 *   - key_fn: function object returning the index of the bucket of an element
+	 *   - buckets: target lists, distinct from `*this`
+	 * Complexity: Exactly `size()` applications of `key_fn`, and constant work per element.
+	 * Exceptions: `std::out_of_range` if `key_fn` returns an index past the last bucket. If an exception is thrown,
+	 * the elements already distributed are in their bucket, the others in `*this`.
+	 */
+	template <class KeyFn> void distribute(KeyFn key_fn, std::span<xorlist> buckets) {
+		if (_dead != 0)
+			purge();
+
+		const __node_pointer __s = __end_node();
+
+		while (_head != __s) {
+			const __node_pointer __x = _head;
+			const std::size_t __k = static_cast<std::size_t>(key_fn(std::as_const(__x->_value)));
+
+			if (__k >= buckets.size())
+				throw std::out_of_range("xorlist::distribute: bucket index out of range");
+
+			xorlist &__b = buckets[__k];
+
+			__pop_front_node();
+			__b.__link_node(__b.__last_node(), __x, __b.__end_node());
+			++__b._size;
+		}
+	}
+
+	/* Set operations */
+
+	/*
+	 * Moves the union of the sorted lists `*this` and `other` to the back of `out`, in a single merge pass. As with
+	 * `std::set_union`, an element found `m` times in `*this` and `n` times in `other` appears `max(m, n)` times, the
+	 * first `m` being those of `*this`. Both inputs are emptied; the nodes are relinked, never copied nor moved.
+	 * Parameters:
+	 *   - other: another list sorted with respect to `comp`
+	 *   - out: list receiving the result, distinct from the inputs
+	 *   - comp: comparison function object which returns `true` if the first argument is ordered before the second
+	 * Return value: The rejected elements, in the order they were met; they are destroyed in bulk unless kept.
+	 * Complexity: At most `size() + other.size() - 1` comparisons.
+	 * Exceptions: If `comp` throws, the elements already processed are in `out` or destroyed, the others remain in
+	 * their input.
+	 */
+	template <class Compare = std::less<value_type>>
+	xorlist set_union_into(xorlist &other, xorlist &out, Compare comp = Compare()) {
+		return __set_operation(other, out, comp, true, true, true);
+	}
+
+	/*
+	 * Moves the intersection of the sorted lists `*this` and `other` to the back of `out`, like `set_union_into`. As
+	 * with `std::set_intersection`, an element found `m` times in `*this` and `n` times in `other` appears `min(m, n)`
+	 * times, taken from `*this`.
+	 */
+	template <class Compare = std::less<value_type>>
+	xorlist set_intersection_into(xorlist &other, xorlist &out, Compare comp = Compare()) {
+		return __set_operation(other, out, comp, false, false, true);
+	}
+
+	/*
+	 * Moves the elements of the sorted list `*this` not found in the sorted list `other` to the back of `out`, like
+	 * `set_union_into`. As with `std::set_difference`, an element found `m` times in `*this` and `n` times in `other`
+	 * appears `max(m - n, 0)` times.
+	 */
+	template <class Compare = std::less<value_type>>
+	xorlist set_difference_into(xorlist &other, xorlist &out, Compare comp = Compare()) {
+		return __set_operation(other, out, comp, true, false, false);
+	}
+
+	/*
+	 * Moves the elements found in only one of the sorted lists `*this` and `other` to the back of `out`, like
+	 * `set_union_into`. As with `std::set_symmetric_difference`, an element found `m` times in `*this` and `n` times
+	 * in `other` appears `|m - n|` times.
+	 */
+	template <class Compare = std::less<value_type>>
+	xorlist set_symmetric_difference_into(xorlist &other, xorlist &out, Compare comp = Compare()) {
+		return __set_operation(other, out, comp, true, true, false);
+	}
+
+	/* Selection */
+
+	/*
+	 * Rearranges the elements so that the `k` smallest ones, with respect to `comp`, come first in sorted order. A
+	 * first pass keeps the `k` best node pointers seen so far in a bounded max-heap, whose top ends up being the `k`-th
+	 * smallest element; a second pass unlinks the elements ordered before it, and as many equivalent ones as needed,
+	 * which are then sorted and linked at the front. The other elements keep their relative order, and equivalent
+	 * elements among the first `k` keep theirs too. No element is copied or moved.
+	 * Parameters:
+	 *   - k: number of elements to select, all of them if greater than `size()`
+	 *   - comp: comparison function object which returns `true` if the first argument is ordered before the second
+	 * Return value: Iterator to the element following the sorted prefix.
+	 * Complexity: `N log k` comparisons for the selection and `k log k` for the sort, where `N` is `size()`. The
+	 * function needs a buffer of `k` node pointers.
+	 * Exceptions: If `comp` throws, the elements are left in an unspecified order, but none is lost.
+	 */
+	template <class Compare = std::less<value_type>> iterator partial_sort(size_type k, Compare comp = Compare()) {
+		if (_dead != 0)
+			purge();
+
+		k = std::min(k, _size);
+
+		if (k == 0)
+			return begin();
+
+		const auto __before = [&](__node_pointer __a, __node_pointer __b) { return comp(__a->_value, __b->_value); };
+		const __node_pointer __s = __end_node();
+		__node_buffer __best{__buffer_allocator(__node_alloc())};
+		__best.reserve(k);
+
+		for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s;) {
+			if (__best.size() < k) {
+				__best.push_back(__cur);
+				std::push_heap(__best.begin(), __best.end(), __before);
+			} else if (__before(__cur, __best.front())) {
+				std::pop_heap(__best.begin(), __best.end(), __before);
+				__best.back() = __cur;
+				std::push_heap(__best.begin(), __best.end(), __before);
+			}
+
+			__prev = std::exchange(__cur, __next_node(__prev, __cur));
+		}
+
+		// the `k`-th smallest element; ties with it are taken in list order
+		const __node_pointer __kth = __best.front();
+		size_type __ties = static_cast<size_type>(std::count_if(
+			__best.begin(), __best.end(), [&](__node_pointer __x) { return !__before(__x, __kth); }));
+
+		__best.clear();
+
+		// the taken nodes are also chained, so that they can be linked back if `comp` throws
+		__chain __taken;
+
+		try {
+			for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s && __best.size() < k;) {
+				const __node_pointer __next = __next_node(__prev, __cur);
+
+				bool __take = __before(__cur, __kth);
+
+				if (!__take && __ties != 0 && !__before(__kth, __cur)) {
+					__take = true;
+					--__ties;
+				}
+
+				if (__take) {
+					__unlink_node(__prev, __cur, __next);
+					__taken.__push_back(__cur);
+					__best.push_back(__cur);
+				} else
+					__prev = __cur;
+
+				__cur = __next;
+			}
+
+			std::stable_sort(__best.begin(), __best.end(), __before);
+		} catch (...) {
+			if (__taken._first != nullptr)
+				__link_range(__s, __taken._first, __taken._last, __first_node());
+			throw;
+		}
+
+		iterator __pos = begin();
+
+		for (const __node_pointer __x : __best) {
+			__link_node(__pos._prev, __x, __pos._cur);
+			__pos._prev = __x;
+		}
+
+		return __pos;
+	}
+
+	/*
+	 * Rearranges the elements so that the element at position `n` is the one that would be there if the list were
+	 * sorted, the elements before it are not ordered after it, and the elements after it are not ordered before it.
+	 * The node pointers are gathered in a buffer on which `std::nth_element` runs a quickselect, then the ring is
+	 * rebuilt in the resulting order. No element is copied or moved.
+	 * Parameters:
+	 *   - n: position of the element to select
+	 *   - comp: comparison function object which returns `true` if the first argument is ordered before the second
+	 * Return value: Iterator to the `n`-th element, or `end()`, leaving the order unchanged, if `n` is not less than
+	 * `size()`.
+	 * Complexity: Linear in `size()` on average. The function needs a buffer of `size()` node pointers.
+	 */
+	template <class Compare = std::less<value_type>> iterator nth_element(size_type n, Compare comp = Compare()) {
+		if (n >= _size)
+			return end();
+
+		if (_dead != 0)
+			purge();
+
+		__node_buffer __nodes{__buffer_allocator(__node_alloc())};
+		__nodes.reserve(_size);
+
+		const __node_pointer __s = __end_node();
+
+		for (__node_pointer __prev = __s, __cur = __first_node(); __cur != __s;)
+			__nodes.push_back(__prev = std::exchange(__cur, __next_node(__prev, __cur)));
+
+		std::nth_element(__nodes.begin(), __nodes.begin() + static_cast<difference_type>(n), __nodes.end(),
+						 [&](__node_pointer __a, __node_pointer __b) { return comp(__a->_value, __b->_value); });
+		__relink_all(__nodes.data(), __nodes.data() + __nodes.size());
+
+		return iterator(n == 0 ? __s : __nodes[n - 1], __nodes[n]);
+	}
+
+	/* Tombstones */
+
+	/*
+	 * Returns the share of dead nodes above which a lazily erasing container compacts itself. `0` (the default) means
+	 * that `erase` and `remove_if` unlink and destroy elements immediately.
+	 * Complexity: Constant.
+	 */
+	float max_dead_ratio() const noexcept { return _max_dead_ratio; }
+
+	/*
+	 * Sets the tombstone threshold. With a positive `ratio`, `erase` and `remove_if` only mark nodes dead, iterators
+	 * skip them, and the element and its node are destroyed later, in a single sweep, once dead nodes make up more than
+	 * `ratio` of all the nodes in the ring or on `purge()`. A ratio of `0` disables tombstoning and purges immediately.
+	 * Parameters:
+	 *   - ratio: new threshold, in `[0, 1]`
+	 * Complexity: Linear in the number of nodes if a purge is triggered, otherwise constant.
+	 * Notes: Iterators and references to elements remain valid until the next purge, which invalidates iterators whose
+	 * predecessor node was dead.
+	 */
+	void max_dead_ratio(float ratio) noexcept {
+		_max_dead_ratio = std::max(ratio, 0.0f);
+
+		if (__lazy_erase())
+			__compact(__end_node(), __end_node());
+		else if (_dead != 0)
+			purge();
+	}
+
+	/*
+	 * Unlinks and destroys all the nodes marked dead by a lazy `erase` or `remove_if`, in a single pass.
+	 * Complexity: Linear in the number of nodes, live or dead.
 	 */
-	template <class Compare> void sort(Compare comp) { throw std::logic_error::logic_error("Not yet implemented"); }
+	void purge() noexcept { __purge(__end_node()); }
 
   private:
-	inline void __unlink_nodes(_node<T> *__f, _node<T> *__l) noexcept {
-		__f->_link = __f;
-		__l->_link = __l;
+	/* Links */
+
+	// A node's `_link` holds the XOR of the addresses of its two neighbours; the ring is closed by `_end`. Nodes are
+	// at least pointer-aligned, so the lowest bit of the XOR is free and marks tombstoned nodes.
+	static constexpr std::uintptr_t __dead_bit = 1;
+
+	static std::uintptr_t __bits(__node_pointer __p) noexcept {
+		return reinterpret_cast<std::uintptr_t>(std::to_address(__p));
+	}
+
+	static __node_pointer __xor(__node_pointer __a, __node_pointer __b) noexcept {
+		return reinterpret_cast<__node_pointer>(__bits(__a) ^ __bits(__b));
+	}
+
+	__node_pointer __end_node() const noexcept { return const_cast<_node<value_type> &>(_end)._self(); }
+
+	__node_pointer __first_node() const noexcept { return _head; }
+
+	__node_pointer __last_node() const noexcept { return __xor(_end._link, _head); }
+
+	// Neighbour of `__cur` on the side opposite to `__prev`.
+	static __node_pointer __next_node(__node_pointer __prev, __node_pointer __cur) noexcept {
+		return reinterpret_cast<__node_pointer>((__bits(__cur->_link) ^ __bits(__prev)) & ~__dead_bit);
+	}
+
+	static bool __is_dead(__node_pointer __x) noexcept { return __bits(__x->_link) & __dead_bit; }
+
+	static void __mark_dead(__node_pointer __x) noexcept {
+		__x->_link = reinterpret_cast<__node_pointer>(__bits(__x->_link) | __dead_bit);
+	}
+
+	// Links the detached node `__x` between the adjacent nodes `__p` and `__n`. Does not update `_size`.
+	void __link_node(__node_pointer __p, __node_pointer __x, __node_pointer __n) noexcept {
+		if ((__p == _finger_prev && __n == _finger) || (__p == _finger && __n == _finger_prev))
+			__drop_finger();
+
+		__p->_link = __xor(__p->_link, __xor(__n, __x));
+		__n->_link = __xor(__n->_link, __xor(__p, __x));
+		__x->_link = __xor(__p, __n);
+
+		if (__p == __end_node())
+			_head = __x;
+	}
+
+	// Unlinks `__x` from between its neighbours `__p` and `__n`, leaving its `_link` as is. Does not update `_size`.
+	void __unlink_node(__node_pointer __p, __node_pointer __x, __node_pointer __n) noexcept {
+		if (__x == _finger || __x == _finger_prev)
+			__drop_finger();
+
+		__p->_link = __xor(__p->_link, __xor(__x, __n));
+		__n->_link = __xor(__n->_link, __xor(__x, __p));
+
+		if (__p == __end_node())
+			_head = __n;
+	}
+
+	// Fibonacci hashing: spreads identity-like hashes over the `__bits` high bits of the product.
+	static std::size_t __hash_slot(std::size_t __h, int __bits) noexcept {
+		return static_cast<std::size_t>((static_cast<std::uint64_t>(__h) * 0x9E3779B97F4A7C15ull) >> (64 - __bits));
+	}
+
+	// Detaches the nodes `[__f, __l]`, found between `__p` and `__n`, into a chain whose ends link to null.
+	void __unlink_range(__node_pointer __p, __node_pointer __f, __node_pointer __l, __node_pointer __n) noexcept {
+		__drop_finger();
+		__p->_link = __xor(__p->_link, __xor(__f, __n));
+		__n->_link = __xor(__n->_link, __xor(__l, __p));
+		__f->_link = __xor(__f->_link, __p);
+		__l->_link = __xor(__l->_link, __n);
+
+		if (__p == __end_node())
+			_head = __n;
+	}
+
+	// Links a detached chain `[__f, __l]` between the adjacent nodes `__p` and `__n`. Does not update `_size`.
+	void __link_range(__node_pointer __p, __node_pointer __f, __node_pointer __l, __node_pointer __n) noexcept {
+		__drop_finger();
+		__f->_link = __xor(__f->_link, __p);
+		__l->_link = __xor(__l->_link, __n);
+		__p->_link = __xor(__p->_link, __xor(__n, __f));
+		__n->_link = __xor(__n->_link, __xor(__p, __l));
+
+		if (__p == __end_node())
+			_head = __f;
+	}
+
+	/* Finger */
+
+	void __drop_finger() noexcept { _finger_prev = _finger = nullptr; }
+
+	template <class V, class Compare> iterator __insert_sorted(V &&__v, Compare &__comp) {
+		iterator __pos = _finger != nullptr && !__is_dead(_finger) ? iterator(_finger_prev, _finger) : end();
+
+		if (__pos != end() && !__comp(__v, *__pos)) {
+			do
+				++__pos;
+			while (__pos != end() && !__comp(__v, *__pos));
+		} else {
+			for (const iterator __first = begin(); __pos != __first;) {
+				const iterator __before = std::prev(__pos);
+
+				if (!__comp(__v, *__before))
+					break;
+
+				__pos = __before;
+			}
+		}
+
+		const __node_pointer __x = __create_node(std::forward<V>(__v));
+		__link_node(__pos._prev, __x, __pos._cur);
+		++_size;
+		_finger_prev = __pos._prev;
+		_finger = __x;
+
+		return iterator(__pos._prev, __x);
+	}
+
+	/* Tombstones */
+
+	bool __lazy_erase() const noexcept { return _max_dead_ratio > 0.0f; }
+
+	// Purges if the share of dead nodes crossed the threshold; returns the (possibly new) predecessor of `__at`.
+	__node_pointer __compact(__node_pointer __p, __node_pointer __at) noexcept {
+		if (_dead == 0 || _dead <= _max_dead_ratio * static_cast<float>(_size + _dead))
+			return __p;
+
+		return __purge(__at);
+	}
+
+	// Unlinks and frees every dead node in a single sweep; returns the predecessor of the live node (or `_end`) `__at`.
+	__node_pointer __purge(__node_pointer __at) noexcept {
+		const __node_pointer __s = __end_node();
+		__node_pointer __dead = nullptr; // unlinked nodes, chained through `_link`
+		__node_pointer __before = __s;
+
+		for (__node_pointer __prev = __s, __cur = __first_node();; ) {
+			if (__cur == __at)
+				__before = __prev;
+			if (__cur == __s)
+				break;
+
+			const __node_pointer __next = __next_node(__prev, __cur);
+
+			if (__is_dead(__cur)) {
+				__unlink_node(__prev, __cur, __next);
+				__cur->_link = __dead;
+				__dead = __cur;
+			} else
+				__prev = __cur;
+
+			__cur = __next;
+		}
+
+		_dead = 0;
+		__destroy_chain(__dead);
+
+		return __before;
+	}
+
+	// Destroys and deallocates a chain of unlinked nodes threaded through their `_link`, in a single sweep.
+	void __destroy_chain(__node_pointer __f) noexcept {
+		__node_allocator &__na = __node_alloc();
+
+		while (__f != nullptr) {
+			const __node_pointer __np = __f;
+			__f = __f->_link;
+			__node_alloc_traits::destroy(__na, std::addressof(__np->_value));
+			__node_alloc_traits::deallocate(__na, __np, 1);
+		}
+	}
+
+	// A detached chain built by appending nodes; its ends link to null.
+	struct __chain {
+		__node_pointer _first{}, _last{};
+		size_type _size = 0;
+
+		void __push_back(__node_pointer __x) noexcept {
+			__x->_link = _last;
+
+			if (_last == nullptr)
+				_first = __x;
+			else
+				_last->_link = __xor(_last->_link, __x);
+
+			_last = __x;
+			++_size;
+		}
+
+		// Unlinks the first node, which must exist, and returns it.
+		__node_pointer __pop_front() noexcept {
+			const __node_pointer __x = _first;
+
+			_first = __x->_link;
+			--_size;
+
+			if (_first == nullptr)
+				_last = nullptr;
+			else
+				_first->_link = __xor(_first->_link, __x);
+
+			return __x;
+		}
+
+		// Links `__c` at the back of the chain and empties it.
+		void __append(__chain &__c) noexcept {
+			if (__c._first == nullptr)
+				return;
+
+			if (_last == nullptr) {
+				_first = __c._first;
+			} else {
+				_last->_link = __xor(_last->_link, __c._first);
+				__c._first->_link = __xor(__c._first->_link, _last);
+			}
+
+			_last = __c._last;
+			_size += std::exchange(__c, __chain{})._size;
+		}
+	};
+
+	/*
+	 * Moves the nodes of the chains `__a` and `__b`, sorted with respect to `__before`, to the back of `__out` in
+	 * sorted order; on ties the node of `__a` comes first. Every node stays in one of the three chains if `__before`
+	 * throws.
+	 */
+	template <class Before> static void __merge_chains(__chain &__a, __chain &__b, __chain &__out, Before &__before) {
+		while (__a._first != nullptr && __b._first != nullptr)
+			__out.__push_back((__before(__b._first, __a._first) ? __b : __a).__pop_front());
+
+		__out.__append(__a);
+		__out.__append(__b);
+	}
+
+	// Links `__c` at the back of the list and empties it.
+	void __append_chain(__chain &__c) noexcept {
+		if (__c._first != nullptr) {
+			__link_range(__last_node(), __c._first, __c._last, __end_node());
+			_size += std::exchange(__c._size, 0);
+			__c._first = __c._last = nullptr;
+		}
+	}
+
+	// Rethreads the nodes of a detached chain through their `_link`, for `__destroy_chain`.
+	static __node_pointer __thread_chain(const __chain &__c) noexcept {
+		for (__node_pointer __p = nullptr, __x = __c._first; __x != nullptr;) {
+			const __node_pointer __n = __xor(__x->_link, __p);
+			__x->_link = __n;
+			__p = __x;
+			__x = __n;
+		}
+
+		return __c._first;
+	}
+
+	// Unlinks the first node, which must exist, and returns it. Updates `_size`.
+	__node_pointer __pop_front_node() noexcept {
+		const __node_pointer __s = __end_node();
+		const __node_pointer __x = _head;
+
+		__unlink_node(__s, __x, __next_node(__s, __x));
+		--_size;
+
+		return __x;
+	}
+
+	/*
+	 * Merges `*this` and `other` by popping their fronts. An element only in `*this`, only in `other`, or in both (the
+	 * one of `*this`; the one of `other` is always rejected) goes to `__out` if the matching flag is set, and to the
+	 * returned list otherwise.
+	 */
+	template <class Compare>
+	xorlist __set_operation(xorlist &other, xorlist &__out, Compare &comp, bool __only_this, bool __only_other,
+							bool __both) {
+		if (_dead != 0)
+			purge();
+		if (other._dead != 0)
+			other.purge();
+
+		xorlist __rejected(get_allocator());
+		__chain __kept, __dropped;
+
+		try {
+			while (!empty() && !other.empty()) {
+				if (comp(front(), other.front()))
+					(__only_this ? __kept : __dropped).__push_back(__pop_front_node());
+				else if (comp(other.front(), front()))
+					(__only_other ? __kept : __dropped).__push_back(other.__pop_front_node());
+				else {
+					(__both ? __kept : __dropped).__push_back(__pop_front_node());
+					__dropped.__push_back(other.__pop_front_node());
+				}
+			}
+		} catch (...) {
+			__out.__append_chain(__kept);
+			__rejected.__append_chain(__dropped);
+			throw;
+		}
+
+		__out.__append_chain(__kept);
+		__rejected.__append_chain(__dropped);
+		xorlist &__rest_of_this = __only_this ? __out : __rejected;
+		xorlist &__rest_of_other = __only_other ? __out : __rejected;
+		__rest_of_this.splice(__rest_of_this.end(), *this);
+		__rest_of_other.splice(__rest_of_other.end(), other);
+
+		return __rejected;
+	}
+
+	// Rebuilds the ring from the live nodes of `[__f, __l)`, in that order.
+	void __relink_all(__node_pointer *__f, __node_pointer *__l) noexcept {
+		const __node_pointer __s = __end_node();
+
+		__drop_finger();
+
+		if (__f == __l) {
+			_end._link = nullptr;
+			_head = __s;
+			return;
+		}
+
+		_head = *__f;
+		_end._link = __xor(__l[-1], *__f);
+
+		for (__node_pointer __prev = __s; __f != __l; __prev = *__f++)
+			(*__f)->_link = __xor(__prev, __f + 1 == __l ? __s : __f[1]);
+	}
+
+	// Destroys the detached nodes of `[__f, __l)`, threading them into a chain first.
+	void __destroy_buffer(__node_pointer *__f, __node_pointer *__l) noexcept {
+		__node_pointer __chain = nullptr;
+
+		for (; __f != __l; ++__f) {
+			(*__f)->_link = __chain;
+			__chain = *__f;
+		}
+
+		__destroy_chain(__chain);
+	}
+
+	/* Allocation */
+
+	template <class... Args> __node_pointer __create_node(Args &&...args) {
+		__node_allocator &__na = __node_alloc();
+		const __node_pointer __x = __node_alloc_traits::allocate(__na, 1);
+
+		try {
+			__node_alloc_traits::construct(__na, std::addressof(__x->_value), std::forward<Args>(args)...);
+		} catch (...) {
+			__node_alloc_traits::deallocate(__na, __x, 1);
+			throw;
+		}
+
+		__x->_link = nullptr;
+
+		return __x;
 	}
 
 	size_type __node_alloc_max_size() const noexcept { return __node_alloc_traits::max_size(alloc); }
@@ -1300,6 +2409,15 @@ export template <typename T, class Allocator = std::allocator<T>> class xorlist
 				clear();
 
 			alloc = other.get_allocator();
+			__node_alloc() = other.__node_alloc();
+		}
+	}
+
+	// The allocator is copied rather than moved, so that `other` remains usable.
+	void _move_assign_alloc(xorlist &other) noexcept {
+		if constexpr (std::allocator_traits<allocator_type>::propagate_on_container_move_assignment::value) {
+			alloc = other.alloc;
+			__node_alloc() = other.__node_alloc();
 		}
 	}
 
@@ -0,0 +1,242 @@
+/*
+ * https://en.wikipedia.org/wiki/Pipeline_(computing)
+ * https://en.cppreference.com/w/cpp/thread
+ */
+export module xorlist_builder;
+
+import <cstddef>;
+
+import <algorithm>;
+import <condition_variable>;
+import <deque>;
+import <exception>;
+import <memory>;
+import <mutex>;
+import <thread>;
+import <utility>;
+import <vector>;
+
+import xorlist;
+
+/**
+ - [x] explicit xorlist_builder(size_type threads, const allocator_type& alloc);
+ - [x] ~xorlist_builder();
+ - [x] template <class Fill> void submit(Fill fill);
+ - [x] list_type finish();
+ - [x] lock_stats lock_statistics();
+ - [x] template <class T, class Allocator, class InputIt, class Parse> xorlist<T, Allocator> parallel_build(InputIt
+ first, InputIt last, Parse parse, std::size_t threads);
+ */
+
+/*
+ * Builds a `xorlist` from chunks of input processed in parallel. Each submitted chunk is filled, by one of the worker
+ * threads, into a private sublist; as soon as the oldest pending chunks are complete, their sublists are spliced, in
+ * submission order and in O(1) each, at the back of the result. Reading the input (the caller submitting chunks),
+ * parsing (the workers) and linking (the splices) thus overlap.
+ * At most `4 * threads` chunks are pending at once: `submit` blocks beyond that, which bounds the memory held by
+ * sublists waiting for a slow predecessor.
+ * The caller and the workers share a single lock, taken once per `submit` and once per chunk by the worker which
+ * fills it; `lock_statistics()` reports how many of those acquisitions had to wait.
+ * Notes: The sublists are created with copies of the allocator of the result and allocate concurrently, so the
+ * allocator must be thread-safe, as `std::allocator` is but `xor_slab_allocator` is not.
+ */
+export template <class T, class Allocator = std::allocator<T>> class xorlist_builder {
+  public:
+	using list_type = xorlist<T, Allocator>;
+	using allocator_type = Allocator;
+	using size_type = std::size_t;
+
+	struct lock_stats {
+		size_type acquisitions = 0; // by `submit`, `finish` and the workers
+		size_type contended = 0;	// acquisitions which found the lock held by another thread
+	};
+
+  private:
+	struct __chunk {
+		list_type _list;
+		bool _done = false;
+
+		explicit __chunk(const allocator_type &alloc) : _list(alloc) {}
+	};
+
+	// Type-erased fill function; unlike `std::function`, accepts move-only callables.
+	struct __fill_base {
+		virtual ~__fill_base() = default;
+		virtual void operator()(list_type &list) = 0;
+	};
+
+	template <class Fill> struct __fill_impl final : __fill_base {
+		Fill _fill;
+
+		explicit __fill_impl(Fill &&fill) : _fill(std::move(fill)) {}
+
+		void operator()(list_type &list) override { _fill(list); }
+	};
+
+	using __task = std::pair<std::unique_ptr<__fill_base>, __chunk *>;
+
+	list_type _result;
+	std::deque<__chunk> _chunks; // submitted but not linked yet, in submission order; elements never move
+	std::deque<__task> _tasks;   // submitted but not started yet
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _work; // a task was submitted, or the builder is stopping
+	std::condition_variable _room; // a chunk was linked
+	size_type _max_pending;
+	lock_stats _stats;		   // only updated while locked
+	std::exception_ptr _error; // first exception thrown by a task
+	bool _stopping = false;
+
+  public:
+	/*
+	 * Starts the worker threads.
+	 * Parameters:
+	 *   - threads: number of worker threads, at least 1
+	 *   - alloc: allocator of the result and of the sublists, must be thread-safe
+	 * Exceptions: `std::system_error` if a thread cannot be started, after the ones already started are joined.
+	 */
+	explicit xorlist_builder(size_type threads = std::thread::hardware_concurrency(),
+							 const allocator_type &alloc = allocator_type())
+		: _result(alloc), _max_pending(4 * std::max<size_type>(threads, 1)) {
+		threads = std::max<size_type>(threads, 1);
+		_workers.reserve(threads);
+
+		try {
+			for (size_type i = 0; i < threads; ++i)
+				_workers.emplace_back([this] { __work(); });
+		} catch (...) {
+			__stop();
+			throw;
+		}
+	}
+
+	xorlist_builder(const xorlist_builder &) = delete;
+	xorlist_builder &operator=(const xorlist_builder &) = delete;
+
+	// Completes the pending chunks and joins the workers; the result is discarded unless `finish()` was called.
+	~xorlist_builder() { __stop(); }
+
+	/*
+	 * Queues a chunk. `fill`, which only needs to be movable, is called on a worker thread with the sublist of the
+	 * chunk, to which it appends the elements it parses; the sublist is linked after those of the chunks submitted
+	 * earlier.
+	 * Exceptions: If `fill` throws, the exception is rethrown by `finish()`.
+	 * Complexity: Constant, after waiting for room if `4 * threads` chunks are pending.
+	 */
+	template <class Fill> void submit(Fill fill) {
+		std::unique_ptr<__fill_base> task = std::make_unique<__fill_impl<Fill>>(std::move(fill));
+		std::unique_lock lock = __lock();
+		_room.wait(lock, [&] { return _chunks.size() < _max_pending; });
+
+		__chunk &chunk = _chunks.emplace_back(_result.get_allocator());
+		_tasks.emplace_back(std::move(task), std::addressof(chunk));
+		_work.notify_one();
+	}
+
+	/*
+	 * Waits for all the chunks to be parsed and linked, then stops the workers. The builder cannot be used anymore.
+	 * Return value: The concatenation of the sublists, in submission order.
+	 * Exceptions: The first exception thrown by a `fill` function, if any.
+	 */
+	list_type finish() {
+		__stop();
+
+		if (_error)
+			std::rethrow_exception(std::exchange(_error, nullptr));
+
+		return std::move(_result);
+	}
+
+	/*
+	 * Returns the number of lock acquisitions so far, and how many of them had to wait for another thread. Waking up
+	 * from a wait for room or work relocks without being counted.
+	 */
+	lock_stats lock_statistics() {
+		std::lock_guard lock(_mutex);
+		return _stats;
+	}
+
+  private:
+	std::unique_lock<std::mutex> __lock() {
+		std::unique_lock lock(_mutex, std::try_to_lock);
+
+		if (!lock.owns_lock()) {
+			lock.lock();
+			++_stats.contended;
+		}
+
+		++_stats.acquisitions;
+		return lock;
+	}
+
+	void __work() {
+		std::unique_lock lock = __lock();
+
+		for (;;) {
+			_work.wait(lock, [&] { return _stopping || !_tasks.empty(); });
+
+			if (_tasks.empty())
+				return;
+
+			__task task = std::move(_tasks.front());
+			_tasks.pop_front();
+			lock.unlock();
+
+			std::exception_ptr error;
+
+			try {
+				(*task.first)(task.second->_list);
+			} catch (...) {
+				error = std::current_exception();
+			}
+
+			lock = __lock();
+
+			if (error && !_error)
+				_error = error;
+
+			task.second->_done = true;
+
+			// link the longest complete prefix
+			for (; !_chunks.empty() && _chunks.front()._done; _chunks.pop_front())
+				_result.splice(_result.end(), _chunks.front()._list);
+
+			_room.notify_all();
+		}
+	}
+
+	void __stop() {
+		{
+			const std::unique_lock lock = __lock();
+
+			if (_stopping)
+				return;
+
+			_stopping = true;
+		}
+
+		_work.notify_all();
+
+		for (std::thread &worker : _workers)
+			worker.join();
+
+		_workers.clear();
+	}
+};
+
+/*
+ * Builds a list from the chunks of `[first, last)` with `threads` workers. `parse(chunk, sublist)` appends the
+ * elements of a chunk to its sublist; chunks are copied into their task.
+ * Return value: The elements of all the chunks, in chunk order.
+ * Exceptions: The first exception thrown by `parse`, if any.
+ */
+export template <class T, class Allocator = std::allocator<T>, class InputIt, class Parse>
+xorlist<T, Allocator> parallel_build(InputIt first, InputIt last, Parse parse,
+									 std::size_t threads = std::thread::hardware_concurrency()) {
+	xorlist_builder<T, Allocator> builder(threads);
+
+	for (; first != last; ++first)
+		builder.submit([parse, chunk = *first](xorlist<T, Allocator> &out) { parse(chunk, out); });
+
+	return builder.finish();
+}